@@ -0,0 +1,106 @@
+/**
+ * @file async_writer.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Thread writing the frames of a simulation
+ *        while the next steps are computed
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _ASYNC_WRITER_HPP_
+#define _ASYNC_WRITER_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "particle_store.hpp"
+
+/**
+ * @brief Writes frames in a background thread. A frame pushed is
+ *        copied in a snapshot (the columns read by the outputs),
+ *        so that the simulation goes on while the writer thread
+ *        serializes it.
+ *
+ *        Snapshots are recycled: with 2 of them (double buffering),
+ *        one is written while the next one is filled. When every
+ *        snapshot waits to be written, push waits for the writer
+ *        (backpressure), so memory stays bounded.
+ *
+ *        Frames are written in the order they are pushed. An error
+ *        of the writer is thrown again by the next push or finish.
+ */
+class AsyncWriter {
+ public:
+  /* Writes a frame: particles and time */
+  using FrameWriter = std::function<void(const ParticleStore&, double)>;
+
+ private:
+  struct Snapshot {
+    ParticleStore particles;
+    double time;
+  };
+
+  FrameWriter _write;
+  std::vector<Snapshot> _snapshots;
+
+  /* Snapshots which can be filled, and those waiting
+     to be written (in order) */
+  std::vector<size_t> _free;
+  std::deque<size_t> _ready;
+
+  std::mutex _mutex;
+  std::condition_variable _snapshotFree;
+  std::condition_variable _snapshotReady;
+  bool _stopping = false;
+  std::exception_ptr _error;
+
+  std::thread _thread;
+
+  /**
+   * @brief Writes the snapshots ready, until finish is called
+   *        and every snapshot is written
+   */
+  void writerLoop();
+
+  /**
+   * @brief Throws the error of the writer, once
+   */
+  void rethrowError();
+
+ public:
+  /**
+   * @brief Starts the writer thread
+   * @param dimension dimension of the particles
+   * @param write called by the writer thread on each frame
+   * @param nbSnapshots number of snapshots, at least 1
+   *                    (2 by default, double buffering)
+   */
+  AsyncWriter(size_t dimension, FrameWriter write, size_t nbSnapshots = 2);
+
+  ~AsyncWriter();
+
+  AsyncWriter(const AsyncWriter&) = delete;
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  /**
+   * @brief Copies the particles in a free snapshot, waiting for one
+   *        if needed, and gives it to the writer thread
+   * @param particles
+   * @param time
+   */
+  void push(const ParticleStore& particles, double time);
+
+  /**
+   * @brief Waits until every frame pushed is written,
+   *        and stops the writer thread
+   */
+  void finish();
+};
+
+#endif  // _ASYNC_WRITER_HPP_
@@ -0,0 +1,193 @@
+/**
+ * @file barnes_hut_tree.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Tree of the particles approximating the gravitation
+ *        of far groups of particles (Barnes-Hut)
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _BARNES_HUT_TREE_HPP_
+#define _BARNES_HUT_TREE_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "particle_store.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * @brief Barnes-Hut tree: the box of the particles is cut in 2^D
+ *        children (binary tree, quadtree or octree), until a box
+ *        holds at most a few particles (leaf). Each node knows the
+ *        mass, the centre of mass and the quadrupole moment of
+ *        its particles.
+ *
+ *        The gravitation of a node on a particle is approximated
+ *        by its moments if the node is seen under an angle smaller
+ *        than the opening angle θ (side / distance < θ), otherwise
+ *        its children are visited. Leaves are summed particle by
+ *        particle. Forces follow the built-in gravitational kernel
+ *        (m_source m_target / r², gravitational constant of 1),
+ *        softened by r² + ε².
+ *
+ *        Nodes are stored in a flat array, the 2^D children of a
+ *        node being contiguous, and particles of a node are a
+ *        contiguous range of the sorted indices. Subtrees below the
+ *        first levels are built in parallel, then appended.
+ */
+class BarnesHutTree {
+ public:
+  static constexpr size_t NO_CHILD = std::numeric_limits<size_t>::max();
+
+  struct Node {
+    /* Box of the node: centre and half of its side */
+    double center[3];
+    double halfSide;
+
+    double massCenter[3];
+    double mass;
+
+    /* Traceless quadrupole around the centre of mass,
+       Q = Σ m (3 d dᵀ - |d|² I): xx, yy, zz, xy, xz, yz */
+    double quadrupole[6];
+
+    /* Index of the first of the 2^D children, NO_CHILD for a leaf */
+    size_t firstChild;
+
+    /* Particles of the node: sorted indices begin to end - 1 */
+    size_t begin;
+    size_t end;
+
+    bool isLeaf() const { return firstChild == NO_CHILD; }
+  };
+
+ private:
+  size_t _dimension;
+  double _openingAngle = 0.5;
+  double _softening = 0;
+  bool _quadrupole = true;
+  size_t _leafSize = 8;
+
+  std::vector<Node> _nodes;
+
+  /* Particles indices, sorted so that each node is a range */
+  std::vector<size_t> _indices;
+
+  /* Nodes where the first levels stop, built in parallel
+     in their own array, then appended to the tree */
+  struct Subtree {
+    size_t node;
+    size_t begin;
+    size_t end;
+    size_t depth;
+  };
+  std::vector<Subtree> _subtrees;
+  std::vector<std::vector<Node>> _subtreeNodes;
+
+  /**
+   * @brief Builds the node nodes[index] (whose box is set) on the
+   *        particles begin to end - 1, and its descendants. With
+   *        subtrees, nodes at depth spawnDepth are not cut but
+   *        added to subtrees.
+   * @param particles
+   * @param nodes
+   * @param index
+   * @param begin
+   * @param end
+   * @param depth
+   * @param spawnDepth
+   * @param subtrees
+   */
+  void buildNode(const ParticleStore& particles, std::vector<Node>& nodes,
+                 size_t index, size_t begin, size_t end, size_t depth,
+                 size_t spawnDepth, std::vector<Subtree>* subtrees);
+
+  /**
+   * @brief Computes the moments of a leaf from its particles
+   * @param particles
+   * @param node
+   */
+  void computeLeafMoments(const ParticleStore& particles, Node& node) const;
+
+  /**
+   * @brief Computes the moments of a node from those of its children
+   * @param nodes
+   * @param index
+   */
+  void computeNodeMoments(std::vector<Node>& nodes, size_t index) const;
+
+  /**
+   * @brief Adds the gravitational forces on particles first to
+   *        last - 1, compiled for dimension D
+   * @param particles
+   * @param first
+   * @param last
+   */
+  template <size_t D>
+  void applyGravitationKernel(ParticleStore& particles, size_t first,
+                              size_t last) const;
+
+ public:
+  /**
+   * @brief Create an empty tree
+   * @param dimension 1, 2 or 3
+   */
+  explicit BarnesHutTree(size_t dimension);
+
+  /**
+   * @brief Set the opening angle θ: a node is approximated by its
+   *        moments if its side over its distance is smaller.
+   *        0 computes every pair exactly.
+   * @param openingAngle 0.5 by default
+   */
+  void setOpeningAngle(double openingAngle);
+  double getOpeningAngle() const { return _openingAngle; }
+
+  /**
+   * @brief Set the softening length ε, avoiding the divergence
+   *        of close encounters
+   * @param softening 0 by default
+   */
+  void setSoftening(double softening);
+  double getSoftening() const { return _softening; }
+
+  /**
+   * @brief Whether nodes are approximated with their quadrupole
+   *        moment, or only with their mass (monopole)
+   * @param quadrupole true by default
+   */
+  void setQuadrupole(bool quadrupole) { _quadrupole = quadrupole; }
+
+  /**
+   * @brief Set the maximum number of particles of a leaf
+   * @param leafSize 8 by default
+   */
+  void setLeafSize(size_t leafSize);
+
+  const std::vector<Node>& getNodes() const { return _nodes; }
+
+  /**
+   * @brief Builds the tree of the particles, with the threads
+   *        of pool if any
+   * @param particles
+   * @param pool
+   */
+  void build(const ParticleStore& particles, ThreadPool* pool = nullptr);
+
+  /**
+   * @brief Adds the gravitational forces of all the particles on
+   *        particles first to last - 1. The tree must have been
+   *        built with these particles. Only the forces of particles
+   *        first to last - 1 are written, so blocks of particles
+   *        can be computed by different threads.
+   * @param particles
+   * @param first
+   * @param last
+   */
+  void applyGravitation(ParticleStore& particles, size_t first,
+                        size_t last) const;
+};
+
+#endif  // _BARNES_HUT_TREE_HPP_
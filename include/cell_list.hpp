@@ -0,0 +1,271 @@
+/**
+ * @file cell_list.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Grid of cells of a GriddedUniverse, stored in flat arrays
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _CELL_LIST_HPP_
+#define _CELL_LIST_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "dimension_kernels.hpp"
+#include "particle_store.hpp"
+#include "thread_pool.hpp"
+#include "vector.hpp"
+
+/**
+ * @brief Read only view on a contiguous range of indices
+ */
+class IndexSpan {
+ private:
+  const size_t* _begin;
+  const size_t* _end;
+
+ public:
+  IndexSpan(const size_t* begin, const size_t* end)
+      : _begin(begin), _end(end) {}
+
+  const size_t* begin() const { return _begin; }
+  const size_t* end() const { return _end; }
+  size_t size() const { return _end - _begin; }
+  bool empty() const { return _begin == _end; }
+};
+
+/**
+ * @brief Cells are elementary bricks forming a grid of the universe.
+ *        Intern cells cover the universe. For a PERIODIC universe,
+ *        border cells surround them and contain copies (ghosts),
+ *        with an offset, of the particles of the intern cell
+ *        on the other side of the universe.
+ *
+ *        Every relation is stored in compressed arrays (CSR):
+ *        the elements of cell c are elements[start[c]] to
+ *        elements[start[c + 1] - 1]. Particles are put in cells
+ *        with a counting sort of their indices, so rebuilding
+ *        the cells does not allocate memory once warmed up.
+ */
+class CellList {
+ private:
+  const DimensionKernels& _kernels;
+  Vector _lowerBound;
+  Vector _upperBound;
+  double _cellSide;
+
+  /* Number of cell in each dimension, not including border cells,
+     and actual side of the cells in each dimension */
+  std::vector<int> _dimensions;
+  Vector _cellSides;
+
+  /* Neighbours of each intern cell (not including itself),
+     by increasing index */
+  std::vector<size_t> _neighbourStart;
+  std::vector<size_t> _neighbours;
+
+  /* Indices of the particles of each intern cell,
+     by increasing index */
+  std::vector<size_t> _cellStart;
+  std::vector<size_t> _cellParticles;
+
+  /* Counting sort buffers: cell of each particle, and for each
+     thread the count then the cursor of each cell in its block
+     of particles */
+  std::vector<size_t> _particleCell;
+  std::vector<std::vector<size_t>> _threadCellCursors;
+
+  /* Border cells: intern cell copied, offset applied on copies,
+     and intern cells on which the copies have an impact */
+  std::vector<size_t> _borderCopyCell;
+  std::vector<Vector> _borderOffset;
+  std::vector<size_t> _borderNeighbourStart;
+  std::vector<size_t> _borderNeighbours;
+
+  /* Copies of particles of the border cells,
+     and index of the particle copied by each ghost */
+  ParticleStore _ghosts;
+  std::vector<size_t> _ghostStart;
+  std::vector<size_t> _ghostSource;
+
+  /**
+   * @brief Give the index of an intern cell by its coordinates
+   * @param coordinates
+   * @return size_t
+   */
+  size_t internCellIndex(const std::vector<int>& coordinates) const;
+
+  /**
+   * @brief Adds to neighbours the intern cells around coordinates given
+   *        (within one cell on each dimension), by increasing index.
+   * @param coordinates coordinates of the center, can be a border cell
+   * @param neighbours
+   */
+  void addNeighbourCells(const std::vector<int>& coordinates,
+                         std::vector<size_t>& neighbours) const;
+
+  /**
+   * @brief Creates the neighbours of intern cells
+   */
+  void createInternCells();
+
+  /**
+   * @brief Creates the border cells, with their copied cell,
+   *        offset and neighbours
+   */
+  void createBorderCells();
+
+  /**
+   * @brief Creates intern and border cells for the current cell side
+   */
+  void createCells();
+
+  /**
+   * @brief Runs job(thread) on the threads of the pool,
+   *        or job(0) without pool
+   * @param pool can be nullptr
+   * @param job
+   */
+  static void runOnThreads(ThreadPool* pool,
+                           const std::function<void(size_t)>& job);
+
+ public:
+  /**
+   * @brief Creates as many cells as fit in the universe bounds,
+   *        enlarged so that they exactly cover the universe
+   *        (a border cell then copies a whole intern cell).
+   *        If the universe is of sizes (1.5, 3) and the cell side
+   *        of 1, we will have a 1x3 grid of cells of sides (1.5, 1).
+   *        Creates also the contouring border cells.
+   * @param lowerBound
+   * @param upperBound
+   * @param cellSide
+   * @param kernels kernels of the universe dimension
+   */
+  CellList(const Vector& lowerBound, const Vector& upperBound,
+           double cellSide, const DimensionKernels& kernels);
+
+  // Getters
+  double getCellSide() const { return _cellSide; }
+  const Vector& getCellSides() const { return _cellSides; }
+  const std::vector<int>& getDimensions() const { return _dimensions; }
+  size_t getNbCells() const { return _cellStart.size() - 1; }
+  size_t getNbBorderCells() const { return _borderCopyCell.size(); }
+  const ParticleStore& getGhosts() const { return _ghosts; }
+  ParticleStore& getGhosts() { return _ghosts; }
+
+  /**
+   * @brief Index of the intern cell containing a particle
+   *        when cells were last filled
+   * @param particle
+   * @return size_t
+   */
+  size_t getParticleCell(size_t particle) const {
+    return _particleCell[particle];
+  }
+
+  /**
+   * @brief Changes the minimal side of the cells.
+   *        All cells are recreated, they have to be filled again.
+   * @param cellSide
+   */
+  void setCellSide(double cellSide);
+
+  /**
+   * @brief Indices of the particles in an intern cell
+   * @param cell
+   * @return IndexSpan
+   */
+  IndexSpan getCellParticles(size_t cell) const {
+    return IndexSpan(_cellParticles.data() + _cellStart[cell],
+                     _cellParticles.data() + _cellStart[cell + 1]);
+  }
+
+  /**
+   * @brief Intern cells neighbours of an intern cell
+   * @param cell
+   * @return IndexSpan
+   */
+  IndexSpan getNeighbours(size_t cell) const {
+    return IndexSpan(_neighbours.data() + _neighbourStart[cell],
+                     _neighbours.data() + _neighbourStart[cell + 1]);
+  }
+
+  /**
+   * @brief Intern cells neighbours of an intern cell with a greater
+   *        index: half of the neighbours (4 of 8 in 2D, 13 of 26
+   *        in 3D), so that each pair of neighbour cells is
+   *        visited once.
+   * @param cell
+   * @return IndexSpan
+   */
+  IndexSpan getForwardNeighbours(size_t cell) const {
+    IndexSpan neighbours = getNeighbours(cell);
+    return IndexSpan(
+        std::upper_bound(neighbours.begin(), neighbours.end(), cell),
+        neighbours.end());
+  }
+
+  /**
+   * @brief Intern cells neighbours of a border cell
+   * @param borderCell
+   * @return IndexSpan
+   */
+  IndexSpan getBorderNeighbours(size_t borderCell) const {
+    return IndexSpan(_borderNeighbours.data() + _borderNeighbourStart[borderCell],
+                     _borderNeighbours.data() +
+                         _borderNeighbourStart[borderCell + 1]);
+  }
+
+  /**
+   * @brief Index of the first ghost of a border cell in the ghosts store
+   *        (ghosts of border cell b are from getGhostStart(b)
+   *        to getGhostStart(b + 1) - 1)
+   * @param borderCell
+   * @return size_t
+   */
+  size_t getGhostStart(size_t borderCell) const {
+    return _ghostStart[borderCell];
+  }
+
+  /**
+   * @brief Puts all particles in their cell (counting sort).
+   *        Particles must be inside the bounds.
+   *        With a pool, each thread computes the cells of a block
+   *        of particles and counts them in its own histogram,
+   *        histograms are summed by a prefix sum, then each thread
+   *        scatters its block. Cells are the same as with
+   *        one thread (particles by increasing index).
+   * @param particles
+   * @param pool threads used, if any
+   */
+  void fill(const ParticleStore& particles, ThreadPool* pool = nullptr);
+
+  /**
+   * @brief Copies in the border cells the particles
+   *        of their copied cell, with the offset.
+   *        Cells must have been filled before.
+   * @param particles
+   * @param pool threads used, if any
+   */
+  void fillGhosts(const ParticleStore& particles, ThreadPool* pool = nullptr);
+
+  /**
+   * @brief Updates positions and speeds of the ghosts
+   *        from the particles they copy, without changing
+   *        which particles are copied.
+   * @param particles
+   * @param pool threads used, if any
+   */
+  void refreshGhosts(const ParticleStore& particles,
+                     ThreadPool* pool = nullptr);
+
+  /**
+   * @brief Removes the ghosts of the border cells
+   */
+  void clearGhosts();
+};
+
+#endif  // _CELL_LIST_HPP_
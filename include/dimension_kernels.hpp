@@ -0,0 +1,137 @@
+/**
+ * @file dimension_kernels.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Simulation kernels specialized on the dimension of the universe
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _DIMENSION_KERNELS_HPP_
+#define _DIMENSION_KERNELS_HPP_
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "particle_store.hpp"
+#include "vector.hpp"
+
+/**
+ * @brief Table of the loops over particles, compiled once
+ *        for each possible dimension (1, 2 and 3).
+ *        In each version the loops over coordinates have
+ *        a constant size, so the compiler unrolls them.
+ *        A universe chooses its table once, at construction.
+ */
+struct DimensionKernels {
+  size_t dimension;
+
+  /**
+   * @brief First half of a Stormer Verlet step (kick drift kick) on
+   *        particles first to last - 1, in a single sweep: extends
+   *        the extremum values with the positions and forces
+   *        (maxSquaredForce is squared), kicks (v += f / 2m * dt),
+   *        drifts (x += v * dt), and resets the forces to the uniform
+   *        field (f = m * field). Forces of the step start are not
+   *        needed afterwards, no old forces are kept.
+   */
+  void (*kickDriftAndResetForces)(ParticleStore& particles, double timeStep,
+                                  const Vector& field, size_t first,
+                                  size_t last, Vector& minPosition,
+                                  Vector& maxPosition,
+                                  double& maxSquaredForce);
+
+  /**
+   * @brief Last kick of a Stormer Verlet step (v += f / 2m * dt) on
+   *        particles first to last - 1, in the same sweep as their
+   *        cinetic energy, which is returned
+   */
+  double (*halfKickAndEnergy)(ParticleStore& particles, double timeStep,
+                              size_t first, size_t last);
+
+  /**
+   * @brief Adds to speeds of particles first to last - 1 the impulse
+   *        of forces during timeStep (v += f / m * dt), for multiple
+   *        time stepping and composition schemes
+   */
+  void (*kickSpeeds)(ParticleStore& particles,
+                     const std::vector<Vector>& forces, double timeStep,
+                     size_t first, size_t last);
+
+  /**
+   * @brief Moves particles first to last - 1 at constant speed
+   *        (x += v * dt)
+   */
+  void (*driftPositions)(ParticleStore& particles, double timeStep,
+                         size_t first, size_t last);
+
+  /**
+   * @brief Set all forces to zero
+   */
+  void (*setForcesToZero)(ParticleStore& particles);
+
+  /**
+   * @brief Half the sum of the masses times the squared speeds
+   */
+  double (*cineticEnergy)(const ParticleStore& particles);
+
+  /**
+   * @brief Extends the extremum values with current particles
+   */
+  void (*updateExtremumValues)(const ParticleStore& particles,
+                               Vector& minPosition, Vector& maxPosition,
+                               double& maxForce);
+
+  /**
+   * @brief Reflects particles outside of the bounds
+   *        (position mirrored, speed inverted)
+   */
+  void (*reflectOutOfBounds)(ParticleStore& particles, const Vector& lowerBound,
+                             const Vector& upperBound);
+
+  /**
+   * @brief Teleports particles outside of the bounds
+   *        to the other side
+   */
+  void (*teleportOutOfBounds)(ParticleStore& particles,
+                              const Vector& lowerBound,
+                              const Vector& upperBound);
+
+  /**
+   * @brief Index of the cell (in a grid of cells of side cellSides[i]
+   *        and dimensions[i] cells on dimension i) containing position.
+   *        Position must be inside the bounds.
+   */
+  size_t (*cellIndex)(const Vector& position, const Vector& lowerBound,
+                      const Vector& cellSides,
+                      const std::vector<int>& dimensions);
+};
+
+/**
+ * @brief Get the kernels table compiled for the dimension given
+ * @param dimension 1, 2 or 3
+ * @return const DimensionKernels&
+ */
+const DimensionKernels& getDimensionKernels(size_t dimension);
+
+/**
+ * @brief Calls f with the dimension as a compile time constant,
+ *        i.e. f(std::integral_constant<size_t, D>()) with D = dimension.
+ * @param dimension 1, 2 or 3
+ * @param f generic callable
+ */
+template <class F>
+decltype(auto) dispatchDimension(size_t dimension, F&& f) {
+  switch (dimension) {
+    case 1:
+      return f(std::integral_constant<size_t, 1>());
+    case 2:
+      return f(std::integral_constant<size_t, 2>());
+    case 3:
+      return f(std::integral_constant<size_t, 3>());
+    default:
+      throw std::invalid_argument("Dimension must be 1, 2 or 3.");
+  }
+}
+
+#endif  // _DIMENSION_KERNELS_HPP_
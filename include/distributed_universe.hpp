@@ -0,0 +1,204 @@
+/**
+ * @file distributed_universe.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief A finite universe split into slabs between MPI processes
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _DISTRIBUTED_UNIVERSE_HPP_
+#define _DISTRIBUTED_UNIVERSE_HPP_
+
+#include <mpi.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cell_list.hpp"
+#include "finite_universe.hpp"
+#include "vector.hpp"
+
+/**
+ * @brief A DistributedUniverse is a finite universe whose grid of cells
+ *        is split between the processes of an MPI communicator.
+ *        Columns of cells along the first dimension are cut in slabs,
+ *        each process owns the particles of its slab.
+ *
+ *        At each force computation, particles that left the slab
+ *        of a process migrate to the owner of their new column, and
+ *        each process receives from its neighbour processes a halo:
+ *        copies of the particles of the column next to its slab,
+ *        the same way border cells copy particles in a PERIODIC
+ *        GriddedUniverse. Halo particles only act on owned particles,
+ *        they are removed once forces are computed.
+ *
+ *        Every process adds the same particles (same program on
+ *        every process), each one keeps those of its slab when
+ *        the simulation starts. Slabs can be rebalanced periodically
+ *        so that each process owns about the same number of particles.
+ */
+class DistributedUniverse : public FiniteUniverse {
+ private:
+  MPI_Comm _comm;
+  int _rank;
+  int _nbRanks;
+
+  /* Distance with which we can neglect interractions,
+     at least the cut-off radius of every interaction */
+  double _cutoff;
+
+  /* Columns of cells along the first dimension: process r owns
+     columns _slabStarts[r] to _slabStarts[r + 1] - 1 */
+  int _nbColumns;
+  double _columnWidth;
+  std::vector<int> _slabStarts;
+
+  /* Cells of the slab and of the halo columns around it */
+  std::optional<CellList> _cells;
+
+  /* Owned particles are the first ones of the store,
+     halo particles follow them during the force computation */
+  size_t _nbOwned = 0;
+
+  /* Slabs are rebalanced every _rebalancePeriod force
+     computations (never if 0) */
+  size_t _rebalancePeriod = 0;
+  size_t _nbForceUpdates = 0;
+
+  /* Exchange buffers, particles packed as doubles */
+  std::vector<std::vector<double>> _sendPackets;
+  std::vector<double> _sendBuffer;
+  std::vector<double> _receiveBuffer;
+
+  /**
+   * @brief Column of a position, consistent with the bounds
+   *        of the columns
+   * @param position
+   * @return int
+   */
+  int columnOf(const Vector& position) const;
+
+  /**
+   * @brief Lower coordinate of a column on the first dimension
+   * @param column
+   * @return double
+   */
+  double columnLowerBound(int column) const;
+
+  /**
+   * @brief Process owning a column
+   * @param column
+   * @return int
+   */
+  int ownerOf(int column) const;
+
+  /**
+   * @brief Creates the cells of the slab and its halo columns
+   */
+  void createLocalCells();
+
+  /**
+   * @brief Sends each packet to its process, and receives
+   *        the packets of the other processes in the receive buffer
+   */
+  void exchangePackets();
+
+  /**
+   * @brief Sends the particles outside of the slab
+   *        to their owner, and adds the particles received
+   */
+  void migrateParticles();
+
+  /**
+   * @brief Sends copies of the particles of the first and last
+   *        columns of the slab to the neighbour processes,
+   *        and adds the copies received after the owned particles
+   */
+  void exchangeHalo();
+
+  /**
+   * @brief Moves the boundaries of the slabs so that each process
+   *        owns about the same number of particles
+   *        (at least one column each)
+   */
+  void rebalance();
+
+  /**
+   * @brief Applies forces between the particles of a cell, and with
+   *        the particles of its forward neighbours, each pair once.
+   *        Pairs of halo particles are skipped.
+   * @param cell
+   * @param batch batch of the thread
+   * @param forces forces buffer of the thread
+   */
+  void applyHalfShellForces(size_t cell, PairBatch& batch,
+                            std::vector<Vector>& forces);
+
+ protected:
+  /**
+   * @brief Migrates particles and exchanges the halo,
+   *        computes forces, then removes the halo
+   */
+  void updateForces() override;
+
+  /**
+   * @brief Applies forces between particles of the slab
+   *        and of the halo
+   */
+  void applyInternInterractionsForces() override;
+
+  /**
+   * @brief Cinetic energy of the particles of all processes
+   * @param cineticEnergy of the particles of the process
+   * @return double
+   */
+  double sumCineticEnergy(double cineticEnergy) const override;
+
+ public:
+  /**
+   * @brief Create a DistributedUniverse on the processes of comm.
+   *        There must be at least as many columns of cells along
+   *        the first dimension as processes.
+   * @param lowerBound one extreme corner of the area of the universe
+   * @param upperBound the other extreme corner, must have greater coordinates
+   * @param cellSide distance with which we can neglect
+   *                 interractions between two particles,
+   *                 at least the cut-off radius of every interaction
+   * @param comm
+   */
+  DistributedUniverse(Vector lowerBound, Vector upperBound, double cellSide,
+                      MPI_Comm comm = MPI_COMM_WORLD);
+
+  int getRank() const { return _rank; }
+  int getNbRanks() const { return _nbRanks; }
+  int getNbColumns() const { return _nbColumns; }
+  const std::vector<int>& getSlabStarts() const { return _slabStarts; }
+
+  /**
+   * @brief Number of particles owned by all the processes
+   * @return size_t
+   */
+  size_t getGlobalNbParticles() const;
+
+  /**
+   * @brief Rebalances the slabs every period force computations,
+   *        to follow the changes of density. 0 (default)
+   *        only balances them when the simulation starts.
+   * @param period
+   */
+  void setRebalancePeriod(size_t period) { _rebalancePeriod = period; }
+
+  /**
+   * @brief Simulates the movement of particles in the universe using the
+   *        Störmer-Verlet method. Each process keeps the particles
+   *        of its slab, and writes them in its own file.
+   *        PERIODIC universes and multiple time stepping
+   *        are not supported.
+   * @param timeStep
+   * @param finalTime End time of the simulation
+   */
+  void simulateStormerVerlet(double timeStep, double finalTime) override;
+};
+
+#endif  // _DISTRIBUTED_UNIVERSE_HPP_
@@ -10,34 +10,65 @@
 #define _FORCE_HPP_
 
 #include <functional>
+#include <variant>
 
+#include "particle_store.hpp"
 #include "vector.hpp"
 class Particle;
 
 /**
- * @brief Stores a function that rules a force applied on particles
+ * @brief Uniform gravitational field on the last dimension:
+ *        weight -m G on every particle
+ */
+struct GravityField {
+  double G;
+};
+
+/**
+ * @brief Force computed by a function, for the forces
+ *        without built-in kernel (slow path)
+ */
+struct CustomForce {
+  std::function<void(Particle&)> function;
+};
+
+/* Kernels an external force can be computed with.
+   Built-in kernels are loops on the columns of the particles. */
+using ExternalForceKernel = std::variant<GravityField, CustomForce>;
+
+/**
+ * @brief Rules a force applied on particles
  */
 class ExternalForce {
  private:
-  /* Function containing the force */
-  std::function<void(Particle&)> _forceFunction;
+  ExternalForceKernel _kernel;
 
  public:
-  ExternalForce() {}
+  ExternalForce() : _kernel(CustomForce{nullptr}) {}
 
   ExternalForce(std::function<void(Particle&)> forceFunction)
-      : _forceFunction(forceFunction) {}
+      : _kernel(CustomForce{forceFunction}) {}
+
+  ExternalForce(const ExternalForceKernel& kernel) : _kernel(kernel) {}
 
   void setForceFunction(std::function<void(Particle&)> forceFunction) {
-    _forceFunction = forceFunction;
+    _kernel = CustomForce{forceFunction};
   }
 
+  const ExternalForceKernel& getKernel() const { return _kernel; }
+
   /**
    * @brief Computes and add the force applied on the given particle
    * @param target
-   * @return Vector
    */
-  void applyOn(Particle& target) const { _forceFunction(target); }
+  void applyOn(Particle& target) const;
+
+  /**
+   * @brief Computes and add the force applied on every particle
+   *        of a store
+   * @param particles
+   */
+  void applyOnAll(ParticleStore& particles) const;
 };
 
 #endif  // _FORCE_HPP_
@@ -0,0 +1,91 @@
+/**
+ * @file fft.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Fast Fourier transforms of the grids of a particle mesh
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _FFT_HPP_
+#define _FFT_HPP_
+
+#include <complex>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+/**
+ * @brief Fast Fourier transform of a fixed size (a power of 2),
+ *        radix-2 Cooley-Tukey, with precomputed twiddle
+ *        factors and bit reversal permutation.
+ *        Forward transform is Σ x_j exp(-2iπ jk / n), inverse
+ *        one uses exp(+2iπ jk / n): neither is normalized.
+ */
+class FftPlan {
+ private:
+  size_t _size;
+  std::vector<size_t> _bitReversal;
+
+  /* exp(-2iπ k / size) for k < size / 2 */
+  std::vector<std::complex<double>> _twiddles;
+
+ public:
+  /**
+   * @brief Prepares the transforms of size values
+   * @param size a power of 2
+   */
+  explicit FftPlan(size_t size);
+
+  size_t getSize() const { return _size; }
+
+  /**
+   * @brief Transforms size contiguous values in place
+   * @param data
+   * @param inverse
+   */
+  void transform(std::complex<double>* data, bool inverse) const;
+};
+
+/**
+ * @brief Fourier transform of a grid in dimension 1, 2 or 3, as
+ *        transforms of all its lines along each dimension.
+ *        Grid points are stored with the first dimension
+ *        varying fastest. Lines are shared between threads,
+ *        each one copying its lines in its own buffer.
+ */
+class GridFft {
+ private:
+  std::vector<size_t> _dimensions;
+  std::vector<FftPlan> _plans;
+  size_t _size;
+
+  /* Line being transformed by each thread */
+  std::vector<std::vector<std::complex<double>>> _lines;
+
+ public:
+  /**
+   * @brief Prepares the transforms of a grid
+   * @param dimensions number of points in each dimension,
+   *                   powers of 2
+   */
+  explicit GridFft(const std::vector<size_t>& dimensions);
+
+  const std::vector<size_t>& getDimensions() const { return _dimensions; }
+
+  /**
+   * @brief Number of points of the grid
+   * @return size_t
+   */
+  size_t getSize() const { return _size; }
+
+  /**
+   * @brief Transforms a grid in place (not normalized)
+   * @param grid
+   * @param inverse
+   * @param pool threads sharing the lines, if any
+   */
+  void transform(std::vector<std::complex<double>>& grid, bool inverse,
+                 ThreadPool* pool = nullptr);
+};
+
+#endif  // _FFT_HPP_
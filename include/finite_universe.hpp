@@ -150,6 +150,15 @@ class FiniteUniverse : public Universe {
    */
   void activateReflexionWithForces(double epsilon, double sigma);
 
+  /**
+   * @brief Simulates the movement of particles in the universe using the
+   *        Störmer-Verlet method. Block time steps are not supported,
+   *        particles leaving the universe would not be handled.
+   * @param timeStep
+   * @param finalTime End time of the simulation
+   */
+  void simulateStormerVerlet(double timeStep, double finalTime) override;
+
   /**
    * @brief Overrides the << operator
    * @param strm
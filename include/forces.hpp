@@ -10,6 +10,7 @@
 #define _FORCES_HPP_
 
 #include <cmath>
+#include <limits>
 #include <particle.hpp>
 #include <vector.hpp>
 #include <xassert.hpp>
@@ -23,6 +24,14 @@
  */
 void gravitationalInteraction(const Particle& source, Particle& target);
 
+/**
+ * @brief Computes the gravitational forces between two particles,
+ *        and applies them on both.
+ * @param first
+ * @param second
+ */
+void gravitationalPairInteraction(Particle& first, Particle& second);
+
 /**
  * @brief Computes the Lennard Jones force applied by
  *        source on target particle.
@@ -35,6 +44,59 @@ void gravitationalInteraction(const Particle& source, Particle& target);
 void lennardJonesInteraction(const Particle& source, Particle& target,
                              double epsilon, double sigma);
 
+/**
+ * @brief Computes the Lennard Jones forces between two particles,
+ *        and applies them on both.
+ * @param first
+ * @param second
+ * @param epsilon
+ * @param sigma
+ */
+void lennardJonesPairInteraction(Particle& first, Particle& second,
+                                 double epsilon, double sigma);
+
+/**
+ * @brief Gravitational interaction neglected beyond a cut-off radius
+ *        (never neglected by default)
+ * @param cutoff
+ * @return Interaction
+ */
+Interaction makeGravitationalInteraction(
+    double cutoff = std::numeric_limits<double>::infinity());
+
+/**
+ * @brief Short-range part of the gravitational interaction,
+ *        split with a Gaussian of scale splitScale, the long-range
+ *        part being computed on a mesh (see ParticleMesh)
+ * @param splitScale
+ * @param cutoff
+ * @return Interaction
+ */
+Interaction makeShortRangeGravitationalInteraction(double splitScale,
+                                                   double cutoff);
+
+/**
+ * @brief Lennard Jones interaction neglected beyond a cut-off radius.
+ *        With shiftForce, the force at the cut-off radius is
+ *        subtracted, so that the force goes continuously to 0.
+ * @param epsilon
+ * @param sigma
+ * @param cutoff
+ * @param shiftForce
+ * @return Interaction
+ */
+Interaction makeLennardJonesInteraction(double epsilon, double sigma,
+                                        double cutoff,
+                                        bool shiftForce = false);
+
+/**
+ * @brief Uniform gravitational field, computed on all the particles
+ *        at once (same force as gravitationalForce)
+ * @param G
+ * @return ExternalForce
+ */
+ExternalForce makeGravitationalForce(double G);
+
 /**
  * @brief Adds the gravitational force applied on a particle to the existing
  * force. The gravitational field is applied on the last dimension ot the
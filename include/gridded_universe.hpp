@@ -9,12 +9,14 @@
 #ifndef _GRIDDED_UNIVERSE_HPP_
 #define _GRIDDED_UNIVERSE_HPP_
 
+#include <optional>
 #include <vector>
 
-#include "extern_border_cell.hpp"
+#include "cell_list.hpp"
 #include "finite_universe.hpp"
-#include "intern_cell.hpp"
+#include "particle_mesh.hpp"
 #include "vector.hpp"
+#include "verlet_list.hpp"
 
 /**
  * @brief A GriddedUniverse is a finite universe, separated into cells.
@@ -22,119 +24,108 @@
  */
 class GriddedUniverse : public FiniteUniverse {
  private:
-  double _cellSide;
-
   /* Cells are parts of the finite universe.
-     Store them in a vector because once initialised,
-     we will not delete or instert one cell  inside.
-     But we want to have a rapid access to get the cell
-     by index. */
-  std::vector<InternCell> _internCells;
-
-  /* For PERIODIC universe, cells containg copies of particles
-     at the other side of the universe. They have as neighbours
-     cells on which they must have an impmlact on the other side. */
-  std::vector<ExternBorderCell> _externBorderCells;
-
-  /* Number of cell in each dimension, not including limit cells */
-  std::vector<int> _dimensions;
+     Once initialised, we never delete or insert a cell,
+     only the particles they contain change at each step. */
+  CellList _cells;
 
-  /**
-   * @brief Create an extern border cell
-   */
-  void createExternBorderCell(std::vector<int>& coords, InternCell* copyCell);
+  /* Distance with which we can neglect interractions,
+     derived from the interactions cut-off radii if not given */
+  double _cutoff;
+  bool _deriveCellSide;
 
-  /**
-   * @brief Creates recursively intern cells
-   * @param dimensions
-   * @param indices
-   * @param initialCoords
-   * @param depth
-   */
-  void createInternCellsRecursive(std::vector<int>& coordinates, int depth);
+  /* Each pair of particles is visited once,
+     forces are applied on both particles */
+  bool _halfShell = true;
 
-  /**
-   * @brief Creates recursively extern border cells
-   * @param dimensions
-   * @param indices
-   * @param initialCoords
-   * @param depth
-   */
-  void createExternCellsRecursive(std::vector<int>& coordinates, int depth);
+  /* When activated (positive skin), forces are computed on the
+     pairs of the Verlet list, cells are only used to build it */
+  double _verletSkin = 0;
+  std::optional<VerletList> _verletList;
 
-  /**
-   * @brief Creates as many cells as needed for the universe bounds
-   *        to be INSIDE the grid of cells.
-   *        If the universe is of sizes (1.5, 3) and the cell side
-   *        of 1, we will have a 2x3 grid of cells.
-   *        Creates also the contouring ExternBorderCells.
-   */
-  void cellsCreation();
+  /* Long-range gravitation of a PERIODIC universe, on a mesh
+     created when the simulation starts (if the split scale is set) */
+  double _meshSplitScale = 0;
+  std::optional<ParticleMesh> _particleMesh;
 
   /**
-   * @brief Give the cell coordinates
-   *        containing the position given
-   * @param pos
-   * @return std::vector<size_t>
+   * @brief Estimated cost of the forces of a cell:
+   *        number of pairs visited with the current traversal
+   * @param cell
+   * @return double
    */
-  std::vector<int> correspondingCellCoordonates(const Vector& pos);
+  double cellWeight(size_t cell) const;
 
   /**
-   * @brief Give the index of an intern cell by its coordinates
-   * @param coordinates
-   * @return size_t
+   * @brief Estimated cost of the forces of the ghosts of a border cell
+   * @param borderCell
+   * @return double
    */
-  size_t internCellIndex(std::vector<int> coordinates);
+  double borderCellWeight(size_t borderCell) const;
 
   /**
-   * @brief Tells if cells of corresponding coordinates are neighbours
-   * @return true
-   * @return false
+   * @brief Applies forces between the particles of a cell, and with
+   *        the particles of its forward neighbours, each pair once
+   *        (adds to existing forces on both particles)
+   * @param cell
+   * @param batch batch of the thread
+   * @param forces forces buffer of the thread
    */
-  inline bool areNeighbours(std::vector<int> coord1, std::vector<int> coord2);
+  void applyHalfShellForces(size_t cell, PairBatch& batch,
+                            std::vector<Vector>& forces);
 
   /**
-   * @brief Set neighbours for each cell
+   * @brief Applies on the particles of a cell the forces of the other
+   *        particles of the cell and of all its neighbours
+   *        (adds to existing forces)
+   * @param cell
+   * @param batch batch of the thread
+   * @param forces forces buffer of the thread
    */
-  void setCellsNeighbours();
+  void applyFullShellForces(size_t cell, PairBatch& batch,
+                            std::vector<Vector>& forces);
 
   /**
-   * @brief Set neighbours of a cell
-   * @param index index of the cell
+   * @brief Updates particles positions
+   *        in Stormer Verlet algorithm.
+   *        Handles change of cell and
+   *        being outside of the finite universe.
    */
-  void setOneInernCellNeighbours(InternCell& internCell);
+  void updatePositions(double timeStep) override;
 
   /**
-   * @brief Set neighbours of a cell
-   * @param index index of the cell
+   * @brief Fill cells with particles in the universe
    */
-  void setOneExternCellNeighbours(ExternBorderCell& borderCell);
+  void fillCells();
 
   /**
-   * @brief Updates particles positions
-   *        in Stormer Verlet algorithm.
-   *        Handles change of cell and
-   *        being outside of the finite universe.
+   * @brief Checks the cell side against the largest cut-off radius
+   *        of the interactions (or derives it), then sizes
+   *        the cells and creates the Verlet list and the particle
+   *        mesh if activated. Throws std::invalid_argument if an
+   *        interaction has a cut-off radius greater than the cell
+   *        side given, or if the mesh is set and the universe
+   *        is not PERIODIC.
    */
-  void updatePositions(double timeStep) override;
+  void setupCells();
 
   /**
-   * @brief Puts the patricle given in the good cell
-   *        in the universe
-   * @param p
+   * @brief Rebuilds the Verlet list if a particle moved too much,
+   *        otherwise only moves the ghosts with their particle
    */
-  void putInCorrespondingCell(Particle* p);
+  void updateVerletList();
 
   /**
-   * @brief delete all particle pointers
-   *        stored in cells
+   * @brief Applies forces between the pairs of the Verlet list,
+   *        in both directions (adds to existing forces)
    */
-  void clearCells();
+  void applyVerletListForces();
 
   /**
-   * @brief Fill cells with particles in the universe
+   * @brief Applies forces of the ghosts of the Verlet list
+   *        on their paired particle (adds to existing forces)
    */
-  void fillCells();
+  void applyVerletListGhostForces();
 
   /**
    * @brief Applies the force implied by the foreign
@@ -151,6 +142,12 @@ class GriddedUniverse : public FiniteUniverse {
    */
   void applyInternInterractionsForces() override;
 
+  /**
+   * @brief Applies forces between particles in the universe,
+   *        then the long-range gravitation of the mesh if any
+   */
+  void applyInteractionForces() override;
+
  public:
   /**
    * @brief Create a GriddedUniverse.
@@ -158,13 +155,68 @@ class GriddedUniverse : public FiniteUniverse {
    *        If a particle quits the domain during the simulation,
    *        it is deleted from the gridded universe.
    * @param cellSide distance with which we can neglect
-   *                  interractions between two particles
+   *                  interractions between two particles,
+   *                  at least the cut-off radius of every interaction
    * @param lowerBound one extreme corner of the area of the universe
    * @param upperBound the other extreme corner, must have greater coordinates
    */
   GriddedUniverse(Vector lowerBound, Vector upperBound, double cellSide);
 
-  const std::vector<int>& getDimensions() const { return _dimensions; }
+  /**
+   * @brief Create a GriddedUniverse whose cell side is the largest
+   *        cut-off radius of its interactions, known
+   *        when the simulation starts.
+   * @param lowerBound one extreme corner of the area of the universe
+   * @param upperBound the other extreme corner, must have greater coordinates
+   */
+  GriddedUniverse(Vector lowerBound, Vector upperBound);
+
+  const std::vector<int>& getDimensions() const {
+    return _cells.getDimensions();
+  }
+
+  /**
+   * @brief Computes forces with a Verlet list instead of cells.
+   *        Pairs closer than cellSide + skin are listed, the list
+   *        is rebuilt only when a particle has moved by more than
+   *        skin / 2. Cells are enlarged to cellSide + skin
+   *        when the simulation starts.
+   * @param skin
+   */
+  void activateVerletList(double skin);
+
+  /**
+   * @brief Chooses the traversal of neighbour cells.
+   *        With half shell (default), each pair of particles is
+   *        visited once and forces are applied on both particles,
+   *        which halves the work. Otherwise each cell receives
+   *        forces from all its neighbours.
+   * @param halfShell
+   */
+  void setHalfShell(bool halfShell) { _halfShell = halfShell; }
+
+  /**
+   * @brief Adds the gravitation between all the particles of a
+   *        PERIODIC universe in dimension 3, with their periodic
+   *        images (P3M): pairs closer than cutoff get the short-range
+   *        part of the force through the cells, the long-range part
+   *        is computed on a mesh. The split scale is cutoff / 5,
+   *        so that the short-range part is negligible beyond cutoff.
+   *        With multiple time stepping, the mesh is computed with
+   *        the first level.
+   * @param cutoff at most the cell side
+   * @param shortRangeLevel time-scale level of the short-range part
+   */
+  void addPeriodicGravitation(double cutoff, size_t shortRangeLevel = 0);
+
+  /**
+   * @brief Number of times the Verlet list was built,
+   *        0 if it is not activated
+   * @return size_t
+   */
+  size_t getNbVerletListBuilds() const {
+    return _verletList ? _verletList->getNbBuilds() : 0;
+  }
 
   friend std::ostream& operator<<(std::ostream& strm, GriddedUniverse universe);
 
@@ -177,4 +229,4 @@ class GriddedUniverse : public FiniteUniverse {
   void simulateStormerVerlet(double timeStep, double finalTime) override;
 };
 
-#endif  // _GRIDDED_UNIVERSE_HPP_
\ No newline at end of file
+#endif  // _GRIDDED_UNIVERSE_HPP_
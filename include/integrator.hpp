@@ -0,0 +1,103 @@
+/**
+ * @file integrator.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Symplectic integrators the universes step through
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _INTEGRATOR_HPP_
+#define _INTEGRATOR_HPP_
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Symplectic integrator, written as a composition of kicks
+ *        (v += d f / m * dt) and drifts (x += c v * dt):
+ *        K(d0) D(c1) K(d1) ... D(cn) K(dn).
+ *
+ *        Forces are computed before a kick when particles drifted
+ *        since the last computation, so the forces of the last
+ *        kick of a step are reused by the first one of the next
+ *        step. A kick of coefficient 0 is skipped: schemes starting
+ *        with a drift (position form) have d0 = dn = 0.
+ *        Higher order schemes cost more force computations per
+ *        step, but reach the same accuracy with much longer steps.
+ */
+class Integrator {
+ private:
+  std::string _name;
+  size_t _order;
+
+  /* d0 to dn */
+  std::vector<double> _kicks;
+
+  /* c1 to cn */
+  std::vector<double> _drifts;
+
+ public:
+  /**
+   * @brief Create an integrator from its coefficients. Drifts and
+   *        kicks must each sum to 1 (the step is consistent).
+   * @param name
+   * @param order order of the global error
+   * @param kicks coefficients d0 to dn
+   * @param drifts coefficients c1 to cn
+   */
+  Integrator(const std::string& name, size_t order,
+             const std::vector<double>& kicks,
+             const std::vector<double>& drifts);
+
+  const std::string& getName() const { return _name; }
+  size_t getOrder() const { return _order; }
+  const std::vector<double>& getKicks() const { return _kicks; }
+  const std::vector<double>& getDrifts() const { return _drifts; }
+
+  /**
+   * @brief Number of force computations of a step,
+   *        once the simulation started
+   * @return size_t
+   */
+  size_t getNbForceComputations() const;
+
+  /**
+   * @brief Tells if the integrator is the Störmer-Verlet
+   *        method (velocity Verlet), K(1/2) D(1) K(1/2)
+   * @return bool
+   */
+  bool isVelocityVerlet() const;
+};
+
+/**
+ * @brief Velocity Verlet (Störmer-Verlet), second order,
+ *        one force computation per step
+ * @return Integrator
+ */
+Integrator makeVelocityVerletIntegrator();
+
+/**
+ * @brief Yoshida's fourth order scheme: three velocity Verlet
+ *        steps of 1 / (2 - 2^(1/3)), -2^(1/3) / (2 - 2^(1/3))
+ *        and 1 / (2 - 2^(1/3)) times the step,
+ *        three force computations per step
+ * @return Integrator
+ */
+Integrator makeYoshida4Integrator();
+
+/**
+ * @brief Forest-Ruth fourth order scheme, the position form
+ *        of Yoshida's one, three force computations per step
+ * @return Integrator
+ */
+Integrator makeForestRuthIntegrator();
+
+/**
+ * @brief Omelyan, Mryglod and Folk fourth order scheme (PEFRL),
+ *        four force computations per step, with an error constant
+ *        about 100 times smaller than Forest-Ruth
+ * @return Integrator
+ */
+Integrator makeOmelyanIntegrator();
+
+#endif  // _INTEGRATOR_HPP_
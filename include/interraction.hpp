@@ -10,31 +10,110 @@
 #define _INTERRACTION_HPP_
 
 #include <functional>
+#include <limits>
+#include <variant>
+
+#include "pair_kernels.hpp"
 
 class Particle;
 
 /**
- * @brief Store a function that rules an interraction between particles
+ * @brief Interaction computed by functions, for the interactions
+ *        without built-in kernel (slow path: an indirect call
+ *        for each pair)
+ */
+struct CustomInteraction {
+  /* force applied by the 1rst particle on the 2nd */
+  std::function<void(const Particle&, Particle&)> function;
+
+  /* optional, applies at once the force on both particles
+     (equal and opposite, Newton's third law) */
+  std::function<void(Particle&, Particle&)> pairFunction;
+};
+
+/* Kernels an interaction can be computed with.
+   Engines visit the variant once for a batch of pairs,
+   built-in kernels are then inlined in the loop on pairs. */
+using InteractionKernel = std::variant<LennardJonesParameters,
+                                       GravitationalParameters,
+                                       CustomInteraction>;
+
+/**
+ * @brief Rules an interraction between particles.
+ *        Beyond its cut-off radius, an interaction is neglected:
+ *        the squared distance is checked before any computation.
  */
 class Interaction {
  private:
-  /* function containing the interaction */
-  std::function<void(const Particle&, Particle&)> _interactionFunction;
+  InteractionKernel _kernel;
+
+  /* cut-off radius, infinite if the interaction is never neglected */
+  double _cutoff;
+  double _squaredCutoff;
 
  public:
+  /**
+   * @brief Interaction computed by a built-in kernel
+   * @param kernel
+   * @param cutoff
+   */
+  Interaction(const InteractionKernel& kernel,
+              double cutoff = std::numeric_limits<double>::infinity())
+      : _kernel(kernel), _cutoff(cutoff), _squaredCutoff(cutoff * cutoff) {}
+
+  Interaction(
+      std::function<void(const Particle&, Particle&)> interactionFunction,
+      double cutoff = std::numeric_limits<double>::infinity())
+      : Interaction(CustomInteraction{interactionFunction, nullptr}, cutoff) {}
+
   Interaction(
-      std::function<void(const Particle&, Particle&)> interactionFunction)
-      : _interactionFunction(interactionFunction) {}
+      std::function<void(const Particle&, Particle&)> interactionFunction,
+      std::function<void(Particle&, Particle&)> pairFunction,
+      double cutoff = std::numeric_limits<double>::infinity())
+      : Interaction(CustomInteraction{interactionFunction, pairFunction},
+                    cutoff) {}
+
+  // Getters
+  const InteractionKernel& getKernel() const { return _kernel; }
+  double getCutoff() const { return _cutoff; }
+  bool hasCutoff() const {
+    return _cutoff != std::numeric_limits<double>::infinity();
+  }
+  bool isBuiltin() const {
+    return !std::holds_alternative<CustomInteraction>(_kernel);
+  }
 
   /**
-   * @brief Computes and applies the force implied by source on target
+   * @brief Tells if the forces on a pair can be computed at once
+   * @return bool
+   */
+  bool isReciprocal() const;
+
+  /**
+   * @brief Tells if two particles are closer than the cut-off radius
+   * @param first
+   * @param second
+   * @return bool
+   */
+  bool isInRange(const Particle& first, const Particle& second) const;
+
+  /**
+   * @brief Computes and applies the force implied by source on target,
+   *        if they are in range
    * @param source the particle that applies force
    * @param target the particle that receives
-   * @return Vector
    */
-  void operator()(const Particle& source, Particle& target) const {
-    _interactionFunction(source, target);
-  }
+  void operator()(const Particle& source, Particle& target) const;
+
+  /**
+   * @brief Computes and applies the forces between two particles,
+   *        on both of them, if they are in range.
+   *        A custom interaction without pair function
+   *        is computed in both directions.
+   * @param first
+   * @param second
+   */
+  void applyOnPair(Particle& first, Particle& second) const;
 };
 
-#endif  // _INTERRACTION_HPP_
\ No newline at end of file
+#endif  // _INTERRACTION_HPP_
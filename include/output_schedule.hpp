@@ -0,0 +1,114 @@
+/**
+ * @file output_schedule.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Steps of a simulation whose state is written
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _OUTPUT_SCHEDULE_HPP_
+#define _OUTPUT_SCHEDULE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Chooses the steps of a simulation written by the outputs
+ *        (trajectory file, VTK files): every k-th step, a number
+ *        of frames evenly spread over the simulation, or the steps
+ *        closest to given times. Other steps are simulated but
+ *        not written.
+ */
+class OutputSchedule {
+ public:
+  enum Kind { STRIDE, FRAME_COUNT, TIMES };
+
+ private:
+  Kind _kind;
+
+  /* Stride (STRIDE) or number of frames (FRAME_COUNT) */
+  size_t _count;
+
+  /* Times of the frames (TIMES), sorted */
+  std::vector<double> _times;
+
+  /* Simulation in progress */
+  double _timeStep = 0;
+  size_t _nbSteps = 0;
+  size_t _nbFrames = 0;
+  size_t _nextFrame = 0;
+
+ public:
+  /**
+   * @brief Create a schedule
+   * @param kind
+   * @param count stride (STRIDE) or number of frames (FRAME_COUNT),
+   *              at least 1
+   * @param times times of the frames (TIMES)
+   */
+  OutputSchedule(Kind kind, size_t count,
+                 const std::vector<double>& times = {});
+
+  Kind getKind() const { return _kind; }
+
+  /**
+   * @brief Starts a simulation
+   * @param timeStep
+   * @param finalTime the simulation runs while the time is lower
+   */
+  void start(double timeStep, double finalTime);
+
+  /**
+   * @brief Number of steps of the simulation started
+   * @return size_t
+   */
+  size_t getNbSteps() const { return _nbSteps; }
+
+  /**
+   * @brief Number of frames written (FRAME_COUNT) by the simulation
+   *        started: the number asked, or every step if there are
+   *        fewer steps
+   * @return size_t
+   */
+  size_t getNbFrames() const { return _nbFrames; }
+
+  /**
+   * @brief Whether a step is written. Steps must be
+   *        asked in order, from 0.
+   * @param step index of the step in the simulation
+   * @param time time of the state written
+   * @return bool
+   */
+  bool isOutputStep(size_t step, double time);
+};
+
+/**
+ * @brief Every step is written
+ * @return OutputSchedule
+ */
+OutputSchedule makeEveryStepSchedule();
+
+/**
+ * @brief Every stride-th step is written, from the first one
+ * @param stride
+ * @return OutputSchedule
+ */
+OutputSchedule makeStrideSchedule(size_t stride);
+
+/**
+ * @brief nbFrames steps evenly spread over the simulation are written,
+ *        from the first one (every step if there are fewer)
+ * @param nbFrames
+ * @return OutputSchedule
+ */
+OutputSchedule makeFrameCountSchedule(size_t nbFrames);
+
+/**
+ * @brief The step closest to each time is written
+ *        (once if several times are closest to the same step)
+ * @param times
+ * @return OutputSchedule
+ */
+OutputSchedule makeTimesSchedule(const std::vector<double>& times);
+
+#endif  // _OUTPUT_SCHEDULE_HPP_
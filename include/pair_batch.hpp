@@ -0,0 +1,122 @@
+/**
+ * @file pair_batch.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Forces between a particle and a batch of other particles
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _PAIR_BATCH_HPP_
+#define _PAIR_BATCH_HPP_
+
+#include <vector>
+
+#include "interraction.hpp"
+#include "pair_kernels.hpp"
+#include "particle_store.hpp"
+#include "vector.hpp"
+
+/**
+ * @brief Batch of source particles acting on one target particle.
+ *        Squared distances of all the pairs are gathered in a
+ *        contiguous buffer, so that the built-in interactions
+ *        are computed by the SIMD kernels, then forces are
+ *        added to the particles. Other interactions are computed
+ *        pair by pair with their functions.
+ *        Buffers are kept between batches, to avoid allocations.
+ */
+class PairBatch {
+ private:
+  const PairKernels& _kernels;
+
+  std::vector<size_t> _sources;
+  std::vector<Vector> _deltas;
+  std::vector<double> _squaredDistances;
+  std::vector<double> _massProducts;
+  std::vector<double> _factors;
+
+  template <size_t D>
+  void applyForcesKernel(ParticleStore& particles, size_t target,
+                         ParticleStore& sources,
+                         const std::vector<Interaction>& interactions,
+                         bool reaction, std::vector<Vector>& forces);
+
+ public:
+  /**
+   * @brief Creates an empty batch
+   * @param kernels batch kernels used, of the best instruction set
+   *                by default
+   */
+  PairBatch(const PairKernels& kernels = getPairKernels())
+      : _kernels(kernels) {}
+
+  const PairKernels& getKernels() const { return _kernels; }
+  size_t size() const { return _sources.size(); }
+
+  /**
+   * @brief Removes all the sources
+   */
+  void clear() { _sources.clear(); }
+
+  /**
+   * @brief Adds a source particle, by its index
+   * @param source
+   */
+  void addSource(size_t source) { _sources.push_back(source); }
+
+  /**
+   * @brief Adds the sources of indices first to last - 1
+   * @param first
+   * @param last
+   */
+  void addSourceRange(size_t first, size_t last) {
+    for (size_t s = first; s < last; s++) _sources.push_back(s);
+  }
+
+  /**
+   * @brief Adds source particles, by their indices
+   * @param indices range of indices (IndexSpan for instance)
+   */
+  template <class Indices>
+  void addSources(const Indices& indices) {
+    _sources.insert(_sources.end(), indices.begin(), indices.end());
+  }
+
+  /**
+   * @brief Applies on the target the forces of every source
+   *        (adds to existing forces)
+   * @param particles store of the target
+   * @param target index of the target
+   * @param sources store of the sources, can be particles
+   * @param interactions
+   * @param reaction if true, the opposite forces are applied
+   *                 on the sources (Newton's third law)
+   */
+  void applyForces(ParticleStore& particles, size_t target,
+                   ParticleStore& sources,
+                   const std::vector<Interaction>& interactions,
+                   bool reaction) {
+    applyForces(particles, target, sources, interactions, reaction,
+                particles.getForces());
+  }
+
+  /**
+   * @brief Same, but the forces of the built-in interactions are
+   *        added to a buffer indexed like the particles, a buffer
+   *        of the thread for instance. Reaction then requires the
+   *        sources to be the particles. Other interactions still
+   *        apply their forces on the particles themselves.
+   * @param particles store of the target
+   * @param target index of the target
+   * @param sources store of the sources, can be particles
+   * @param interactions
+   * @param reaction
+   * @param forces buffer receiving the forces
+   */
+  void applyForces(ParticleStore& particles, size_t target,
+                   ParticleStore& sources,
+                   const std::vector<Interaction>& interactions, bool reaction,
+                   std::vector<Vector>& forces);
+};
+
+#endif  // _PAIR_BATCH_HPP_
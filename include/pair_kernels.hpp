@@ -0,0 +1,125 @@
+/**
+ * @file pair_kernels.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Built-in interaction kernels, computed by batches of pairs
+ *        with the SIMD instructions of the processor
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _PAIR_KERNELS_HPP_
+#define _PAIR_KERNELS_HPP_
+
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief Parameters of the Lennard Jones kernel.
+ *        Force on target is (source - target) * factor, with
+ *        factor = 24 epsilon / r² s6 (1 - 2 s6) - forceShift / r
+ *        and s6 = sigma⁶ / r⁶, 0 beyond the cut-off radius.
+ */
+struct LennardJonesParameters {
+  double epsilon;
+  double sigma6;
+  double forceShift;
+  double squaredCutoff;
+};
+
+/**
+ * @brief Parameters of the gravitational kernel.
+ *        Force on target is (source - target) * factor, with
+ *        factor = m_source m_target / r³, 0 beyond the cut-off radius.
+ *        With a split scale rs, only the short-range part of a
+ *        Gaussian split is kept (the rest being computed on a mesh):
+ *        factor is multiplied by erfc(u) + 2u / √π exp(-u²), u = r / 2rs.
+ */
+struct GravitationalParameters {
+  double squaredCutoff;
+  double splitScale = 0;
+};
+
+/**
+ * @brief Lennard Jones factor of one pair
+ * @param squaredDistance
+ * @param params
+ * @return double
+ */
+inline double lennardJonesFactor(double squaredDistance,
+                                 const LennardJonesParameters& params) {
+  if (!(squaredDistance < params.squaredCutoff)) return 0;
+  double inv2 = 1 / squaredDistance;
+  double s6 = params.sigma6 * inv2 * inv2 * inv2;
+  double factor = 24 * params.epsilon * inv2 * s6 * (1 - 2 * s6);
+  if (params.forceShift != 0) factor -= params.forceShift * std::sqrt(inv2);
+  return factor;
+}
+
+/**
+ * @brief Gravitational factor of one pair
+ * @param squaredDistance
+ * @param massProduct
+ * @param params
+ * @return double
+ */
+inline double gravitationalFactor(double squaredDistance, double massProduct,
+                                  const GravitationalParameters& params) {
+  if (!(squaredDistance < params.squaredCutoff)) return 0;
+  double inv2 = 1 / squaredDistance;
+  double factor = massProduct * inv2 * std::sqrt(inv2);
+  if (params.splitScale != 0) {
+    constexpr double twoOverSqrtPi = 1.1283791670955126;
+    double u = std::sqrt(squaredDistance) / (2 * params.splitScale);
+    factor *= std::erfc(u) + twoOverSqrtPi * u * std::exp(-u * u);
+  }
+  return factor;
+}
+
+/**
+ * @brief Instruction sets for which the kernels are compiled
+ */
+enum class SimdLevel { SCALAR, SSE2, AVX2, AVX512 };
+
+/**
+ * @brief Table of the batch kernels compiled for one instruction set.
+ *        Kernels only use squared distances, reciprocals and
+ *        multiplications (and a square root for the force shift
+ *        and gravitation), and ADD the factor of each pair
+ *        to factors. Split gravitation, which needs erfc,
+ *        is computed by the scalar kernel.
+ */
+struct PairKernels {
+  SimdLevel level;
+  const char* name;
+
+  void (*lennardJones)(const double* squaredDistances, double* factors,
+                       size_t nbPairs, const LennardJonesParameters& params);
+
+  void (*gravitational)(const double* squaredDistances,
+                        const double* massProducts, double* factors,
+                        size_t nbPairs, const GravitationalParameters& params);
+};
+
+/**
+ * @brief Best instruction set supported by the processor
+ *        (and the compiler)
+ * @return SimdLevel
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * @brief Kernels of an instruction set. If it is not supported,
+ *        kernels of the best supported one below are given.
+ * @param level
+ * @return const PairKernels&
+ */
+const PairKernels& getPairKernels(SimdLevel level);
+
+/**
+ * @brief Kernels of the best supported instruction set,
+ *        detected once
+ * @return const PairKernels&
+ */
+const PairKernels& getPairKernels();
+
+#endif  // _PAIR_KERNELS_HPP_
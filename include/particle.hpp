@@ -9,30 +9,33 @@
 #ifndef _PARTICLE_HPP_
 #define _PARTICLE_HPP_
 
-#include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "external_force.hpp"
 #include "interraction.hpp"
+#include "particle_store.hpp"
 #include "vector.hpp"
 
+/**
+ * @brief Handle on one particle of a ParticleStore.
+ *        Copying a Particle does not copy the particle data,
+ *        both copies designate the same particle.
+ */
 class Particle {
  private:
-  size_t _dimension;
-  Vector _position;
-  Vector _speed;
-  Vector _force;
-  Vector _oldForce;
-  double _mass;
-  std::string _name;
-  int _id;
-  static int
-      _particleCount;  // Static variable to count number or created particles
+  ParticleStore* _store;
+  size_t _index;
+
+  /* Store owned by a particle created on its own,
+     outside of any universe */
+  std::shared_ptr<ParticleStore> _ownStore;
 
  public:
   /**
-   * @brief Construct a new Particle object
-   * @param dimension dimension of the particle
+   * @brief Construct a new Particle object,
+   *        stored on its own (not in a universe)
    * @param pos
    * @param speed
    * @param mass
@@ -40,28 +43,49 @@ class Particle {
    */
   Particle(Vector pos, Vector speed, double mass, std::string name);
 
+  /**
+   * @brief Construct a handle on the particle
+   *        of index i in the store
+   * @param store
+   * @param index
+   */
+  Particle(ParticleStore& store, size_t index)
+      : _store(&store), _index(index) {}
+
   // Getters
-  static int getParticleCount() { return _particleCount; }
-  size_t getDimension() const { return _dimension; }
-  const Vector& getPosition() const { return _position; }
-  const Vector& getSpeed() const { return _speed; }
-  const Vector& getForce() const { return _force; }
-  const Vector& getOldForce() const { return _oldForce; }
-  double getMass() const { return _mass; }
-  const std::string& getName() const { return _name; }
+  static int getParticleCount() { return ParticleStore::getParticleCount(); }
+  size_t getIndex() const { return _index; }
+
+  /**
+   * @brief Says if both handles designate the same particle
+   *        (same store and same index)
+   * @param other
+   * @return true
+   * @return false
+   */
+  bool isSameParticle(const Particle& other) const {
+    return _store == other._store && _index == other._index;
+  }
+  size_t getDimension() const { return _store->getDimension(); }
+  const Vector& getPosition() const {
+    return _store->getPositions()[_index];
+  }
+  const Vector& getSpeed() const { return _store->getSpeeds()[_index]; }
+  const Vector& getForce() const { return _store->getForces()[_index]; }
+  double getMass() const { return _store->getMasses()[_index]; }
+  const std::string& getName() const { return _store->getNames()[_index]; }
 
   // Setters
   void setPosCoord(size_t coord, double value);
-  void setPosition(const Vector& pos) { _position = pos; }
-  void setSpeed(const Vector& speed) { _speed = speed; }
-  void setForce(const Vector& force) { _force = force; }
-  void setOldForce(const Vector& oldForce) { _oldForce = oldForce; }
+  void setPosition(const Vector& pos) { _store->getPositions()[_index] = pos; }
+  void setSpeed(const Vector& speed) { _store->getSpeeds()[_index] = speed; }
+  void setForce(const Vector& force) { _store->getForces()[_index] = force; }
 
   /**
    * @brief Multiply the speed by a scalar
    * @param scalar
    */
-  void multiplySpeed(double scalar) { _speed *= scalar; }
+  void multiplySpeed(double scalar) { _store->getSpeeds()[_index] *= scalar; }
 
   /**
    * @brief Adds to the i th force coordinate the value given
@@ -120,7 +144,7 @@ class Particle {
    *        (adds to existing force)
    * @param extForces
    */
-  void applyExternalForces(const std::list<ExternalForce>& extForces);
+  void applyExternalForces(const std::vector<ExternalForce>& extForces);
 
   /**
    * @brief Apply to a particle the force
@@ -129,7 +153,16 @@ class Particle {
    * @param other the particle to apply force on
    */
   void applyInteractionForcesOn(
-      Particle& other, const std::list<Interaction>& interactions) const;
+      Particle& other, const std::vector<Interaction>& interactions) const;
+
+  /**
+   * @brief Apply the forces between the calling particle
+   *        and another one, on both of them
+   *        (adds to existing forces)
+   * @param other
+   */
+  void applyInteractionForcesWith(Particle& other,
+                                  const std::vector<Interaction>& interactions);
 };
 
 #endif  // _PARTICLE_HPP_
\ No newline at end of file
@@ -0,0 +1,116 @@
+/**
+ * @file particle_mesh.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Long-range part of the gravitation of a periodic universe,
+ *        computed on a mesh (particle-particle particle-mesh, P3M)
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _PARTICLE_MESH_HPP_
+#define _PARTICLE_MESH_HPP_
+
+#include <complex>
+#include <vector>
+
+#include "fft.hpp"
+#include "particle_store.hpp"
+#include "thread_pool.hpp"
+#include "vector.hpp"
+
+/**
+ * @brief Mesh computing the long-range gravitation of the particles
+ *        of a periodic box, in dimension 3.
+ *
+ *        The potential 1/r is split with a Gaussian of scale rs:
+ *        erfc(r / 2rs) / r is the short-range part, computed on
+ *        pairs closer than a cut-off radius (a gravitational
+ *        interaction with a split scale), and erf(r / 2rs) / r is
+ *        the long-range part, computed here:
+ *        - masses are spread on the mesh points around them
+ *          (cloud in cell),
+ *        - the Poisson equation is solved in Fourier space,
+ *          φ(k) = -4π ρ(k) exp(-k² rs²) / k², with the periodic
+ *          images of every particle and a uniform background
+ *          cancelling the mean density,
+ *        - accelerations -i k φ(k) are transformed back and
+ *          interpolated at the particles with the same weights.
+ *        The smoothing of both cloud in cell steps is divided out
+ *        in Fourier space. Mesh spacing is at most rs / 1.25,
+ *        the number of points in each dimension a power of 2.
+ */
+class ParticleMesh {
+ private:
+  Vector _lowerBound;
+  double _splitScale;
+  size_t _nbPoints[3];
+  double _spacings[3];
+
+  GridFft _fft;
+
+  /* Density on the mesh, then its transform */
+  std::vector<std::complex<double>> _density;
+
+  /* Field being transformed back */
+  std::vector<std::complex<double>> _field;
+
+  /* Long-range potential of a unit density for each wave vector,
+     normalized and divided by the cloud in cell smoothing */
+  std::vector<double> _greenFunction;
+
+  /* Wave numbers of the mesh indices in each dimension,
+     0 for the Nyquist frequency in derivatives */
+  std::vector<double> _waveNumbers[3];
+
+  /* Acceleration along each dimension on the mesh */
+  std::vector<double> _accelerations[3];
+
+  /**
+   * @brief Mesh points and weights around a position (cloud in cell)
+   * @param position
+   * @param indices indices[d][0] and indices[d][1] are the points
+   *                below and above along d
+   * @param weights weights of these points
+   */
+  void cloudInCell(const Vector& position, size_t indices[3][2],
+                   double weights[3][2]) const;
+
+  /**
+   * @brief Spreads the masses of the particles on the mesh
+   * @param particles
+   */
+  void assignMasses(const ParticleStore& particles);
+
+  /**
+   * @brief Solves the potential of the density and derives
+   *        the accelerations on the mesh
+   * @param pool
+   */
+  void computeAccelerations(ThreadPool* pool);
+
+ public:
+  /**
+   * @brief Create the mesh of a periodic box
+   * @param lowerBound one extreme corner of the box
+   * @param upperBound the other extreme corner, must have greater coordinates
+   * @param splitScale rs, scale of the split between short
+   *                   and long range
+   */
+  ParticleMesh(const Vector& lowerBound, const Vector& upperBound,
+               double splitScale);
+
+  double getSplitScale() const { return _splitScale; }
+  const std::vector<size_t>& getDimensions() const {
+    return _fft.getDimensions();
+  }
+
+  /**
+   * @brief Adds the long-range gravitational forces to the forces
+   *        of the particles, with the threads of pool if any
+   * @param particles must be inside the box
+   * @param pool
+   */
+  void applyForces(ParticleStore& particles, ThreadPool* pool = nullptr);
+};
+
+#endif  // _PARTICLE_MESH_HPP_
@@ -0,0 +1,62 @@
+/**
+ * @file particle_pair_kernel.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Loop of the pair interactions between two particles,
+ *        shared by the interactions and the force functions
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _PARTICLE_PAIR_KERNEL_HPP_
+#define _PARTICLE_PAIR_KERNEL_HPP_
+
+#include <cstddef>
+
+#include "dimension_kernels.hpp"
+#include "particle.hpp"
+#include "vector.hpp"
+
+/**
+ * @brief Pair kernel compiled for dimension D, the loops on
+ *        coordinates are unrolled. Force on target is
+ *        (source - target) * factorOf(r²), and its opposite
+ *        on reaction if it is not null.
+ * @param source
+ * @param target
+ * @param reaction
+ * @param factorOf factor of a squared distance
+ */
+template <size_t D, class Factor>
+inline void pairKernel(const Particle& source, Particle& target,
+                       Particle* reaction, Factor&& factorOf) {
+  const Vector& sourcePosition = source.getPosition();
+  const Vector& targetPosition = target.getPosition();
+  double delta[D];
+  double squaredDistance = 0;
+  for (size_t k = 0; k < D; k++) {
+    delta[k] = sourcePosition[k] - targetPosition[k];
+    squaredDistance += delta[k] * delta[k];
+  }
+  double factor = factorOf(squaredDistance);
+  for (size_t k = 0; k < D; k++) {
+    target.addToForceCoord(k, delta[k] * factor);
+    if (reaction) reaction->addToForceCoord(k, -delta[k] * factor);
+  }
+}
+
+/**
+ * @brief Pair kernel of the dimension of target
+ * @param source
+ * @param target
+ * @param reaction
+ * @param factorOf factor of a squared distance
+ */
+template <class Factor>
+inline void applyPairKernel(const Particle& source, Particle& target,
+                            Particle* reaction, Factor&& factorOf) {
+  dispatchDimension(target.getDimension(), [&](auto d) {
+    pairKernel<decltype(d)::value>(source, target, reaction, factorOf);
+  });
+}
+
+#endif  // _PARTICLE_PAIR_KERNEL_HPP_
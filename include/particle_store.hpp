@@ -0,0 +1,207 @@
+/**
+ * @file particle_store.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Contiguous storage of the particles of a universe
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _PARTICLE_STORE_HPP_
+#define _PARTICLE_STORE_HPP_
+
+#include <string>
+#include <vector>
+
+#include "vector.hpp"
+
+class Particle;
+
+/**
+ * @brief Structure of arrays containing particles.
+ *        Each field (position, speed, force, ...) is stored in
+ *        its own contiguous column, so that passes over all
+ *        the particles stream linearly through memory.
+ *        A particle is designated by its index in the columns,
+ *        Particle objects are only handles on one index.
+ */
+class ParticleStore {
+ private:
+  size_t _dimension;
+
+  /* Hot columns, read or written at each step */
+  std::vector<Vector> _positions;
+  std::vector<Vector> _speeds;
+  std::vector<Vector> _forces;
+  std::vector<double> _masses;
+
+  /* Forces of each time-scale level, kept between
+     steps by multiple time stepping (none otherwise) */
+  std::vector<std::vector<Vector>> _levelForces;
+
+  /* Cold columns, only used for output */
+  std::vector<std::string> _names;
+  std::vector<int> _ids;
+
+  // Static variable to count number of created particles
+  static int _particleCount;
+
+ public:
+  /**
+   * @brief Construct an empty store
+   * @param dimension dimension of the particles stored
+   */
+  ParticleStore(size_t dimension) : _dimension(dimension) {}
+
+  // Getters
+  static int getParticleCount() { return _particleCount; }
+  size_t getDimension() const { return _dimension; }
+  size_t size() const { return _masses.size(); }
+  bool empty() const { return _masses.empty(); }
+
+  // Columns
+  std::vector<Vector>& getPositions() { return _positions; }
+  std::vector<Vector>& getSpeeds() { return _speeds; }
+  std::vector<Vector>& getForces() { return _forces; }
+  const std::vector<Vector>& getPositions() const { return _positions; }
+  const std::vector<Vector>& getSpeeds() const { return _speeds; }
+  const std::vector<Vector>& getForces() const { return _forces; }
+  const std::vector<double>& getMasses() const { return _masses; }
+  const std::vector<std::string>& getNames() const { return _names; }
+  const std::vector<int>& getIds() const { return _ids; }
+
+  /**
+   * @brief Sets the number of columns of level forces
+   *        (multiple time stepping), forces set to zero
+   * @param nbLevels
+   */
+  void setNbForceLevels(size_t nbLevels);
+  size_t getNbForceLevels() const { return _levelForces.size(); }
+  std::vector<Vector>& getLevelForces(size_t level) {
+    return _levelForces[level];
+  }
+  const std::vector<Vector>& getLevelForces(size_t level) const {
+    return _levelForces[level];
+  }
+
+  /**
+   * @brief Adds a particle at the end of the store,
+   *        with a new identifier
+   * @param pos
+   * @param speed
+   * @param mass
+   * @param name
+   * @return size_t index of the added particle
+   */
+  size_t add(const Vector& pos, const Vector& speed, double mass,
+             const std::string& name);
+
+  /**
+   * @brief Adds a particle at the end of the store, keeping
+   *        an identifier given (particle received from another
+   *        process for instance)
+   * @param pos
+   * @param speed
+   * @param mass
+   * @param name
+   * @param id
+   * @return size_t index of the added particle
+   */
+  size_t addWithId(const Vector& pos, const Vector& speed, double mass,
+                   const std::string& name, int id);
+
+  /**
+   * @brief Adds at the end of the store a copy of a particle
+   *        of another store (keeping its identifier)
+   * @param source
+   * @param index index of the particle in source
+   * @return size_t index of the copy
+   */
+  size_t addCopy(const ParticleStore& source, size_t index);
+
+  /**
+   * @brief Overwrites a particle with a copy of a particle
+   *        of another store (keeping its identifier).
+   *        Copies to different particles can be made
+   *        by different threads.
+   * @param source
+   * @param index index of the particle in source
+   * @param destination index of the particle overwritten
+   */
+  void setCopy(const ParticleStore& source, size_t index, size_t destination);
+
+  /**
+   * @brief Copies the columns of source read by the outputs
+   *        (positions, speeds, forces, masses and ids), reusing
+   *        the memory of the columns. Names are not copied
+   *        and there are no level forces.
+   * @param source
+   */
+  void copyOutputColumns(const ParticleStore& source);
+
+  /**
+   * @brief Changes the number of particles. New particles are
+   *        at rest at the origin and must be overwritten
+   *        (by setCopy for instance).
+   * @param n
+   */
+  void resize(size_t n);
+
+  /**
+   * @brief Reserve memory for n particles in every column
+   * @param n
+   */
+  void reserve(size_t n);
+
+  /**
+   * @brief Removes all the particles
+   */
+  void clear();
+
+  /**
+   * @brief Get a handle on the i th particle
+   * @param i
+   * @return Particle
+   */
+  Particle at(size_t i);
+
+  /**
+   * @brief Removes the particles for which the predicate
+   *        (called with their index) is true.
+   *        Remaining particles keep their relative order.
+   *        Linear complexity, indices of the remaining
+   *        particles are invalidated.
+   * @param shouldRemove
+   */
+  template <class Predicate>
+  void removeIf(Predicate shouldRemove);
+};
+
+template <class Predicate>
+void ParticleStore::removeIf(Predicate shouldRemove) {
+  size_t kept = 0;
+  for (size_t i = 0; i < size(); i++) {
+    if (shouldRemove(i)) continue;
+    if (kept != i) {
+      _positions[kept] = _positions[i];
+      _speeds[kept] = _speeds[i];
+      _forces[kept] = _forces[i];
+      _masses[kept] = _masses[i];
+      for (std::vector<Vector>& forces : _levelForces) {
+        forces[kept] = forces[i];
+      }
+      _names[kept] = std::move(_names[i]);
+      _ids[kept] = _ids[i];
+    }
+    kept++;
+  }
+
+  _positions.resize(kept);
+  _speeds.resize(kept);
+  _forces.resize(kept);
+  _masses.resize(kept);
+  for (std::vector<Vector>& forces : _levelForces) forces.resize(kept);
+  _names.resize(kept);
+  _ids.resize(kept);
+}
+
+#endif  // _PARTICLE_STORE_HPP_
@@ -0,0 +1,176 @@
+/**
+ * @file thread_pool.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Threads kept alive between the steps of a simulation
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _THREAD_POOL_HPP_
+#define _THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool of threads running the same job together.
+ *        The calling thread takes part in the job as thread 0,
+ *        so a pool of 1 thread creates no thread at all.
+ *        Threads wait for the next job between two runs,
+ *        they are not created at each step.
+ *
+ *        Tasks of uneven cost are cut in chunks of about the same
+ *        weight, dealt in contiguous blocks to per-thread deques.
+ *        A thread takes the chunks of its deque from the front,
+ *        and once it is empty steals chunks at the back of the
+ *        others (work stealing).
+ */
+class ThreadPool {
+ private:
+  /* Chunks of a thread, chunk indices front to back - 1,
+     on their own cache line */
+  struct alignas(64) ChunkDeque {
+    std::mutex mutex;
+    size_t front = 0;
+    size_t back = 0;
+  };
+
+  /* Number of chunks made for each thread, so that
+     stolen chunks balance the threads */
+  static constexpr size_t CHUNKS_PER_THREAD = 8;
+
+  std::vector<std::thread> _workers;
+  std::vector<ChunkDeque> _deques;
+  std::vector<double> _taskWeights;
+  std::vector<size_t> _chunkStarts;
+
+  std::mutex _mutex;
+  std::condition_variable _jobReady;
+  std::condition_variable _jobDone;
+
+  /* Current job, numbered so that workers run each job once */
+  const std::function<void(size_t)>* _job = nullptr;
+  size_t _jobNumber = 0;
+  size_t _nbRunning = 0;
+  bool _stopping = false;
+  std::exception_ptr _error;
+
+  /**
+   * @brief Waits for jobs and runs them, until the pool is destroyed
+   * @param thread number of the worker, from 1
+   */
+  void workerLoop(size_t thread);
+
+  /**
+   * @brief Deals the chunks made to the deques, in contiguous blocks
+   */
+  void dealChunks();
+
+ public:
+  /**
+   * @brief Creates the threads of the pool
+   * @param nbThreads number of threads including the calling one,
+   *                  0 for the number of cores
+   */
+  explicit ThreadPool(size_t nbThreads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t getNbThreads() const { return _workers.size() + 1; }
+
+  /**
+   * @brief Runs job(thread) on every thread of the pool and waits
+   *        for all of them. An exception thrown by a thread
+   *        is thrown again by run.
+   * @param job
+   */
+  void run(const std::function<void(size_t thread)>& job);
+
+  /**
+   * @brief Runs body(first, last, thread) on chunks of grain tasks
+   *        of [0, nbTasks), dealt in turn to the threads: thread t
+   *        gets chunks t, t + nbThreads... The partition only depends
+   *        on the number of threads, so results are reproducible.
+   * @param nbTasks
+   * @param grain number of tasks of a chunk
+   * @param body
+   */
+  template <class Body>
+  void parallelFor(size_t nbTasks, size_t grain, const Body& body) {
+    grain = std::max<size_t>(grain, 1);
+    size_t stride = grain * getNbThreads();
+    run([&](size_t thread) {
+      for (size_t first = thread * grain; first < nbTasks; first += stride) {
+        body(first, std::min(first + grain, nbTasks), thread);
+      }
+    });
+  }
+
+  /**
+   * @brief Cuts tasks 0 to nbTasks - 1 in consecutive chunks of about
+   *        the same total weight, and deals them to the deques
+   *        of the threads
+   * @param nbTasks
+   * @param weight weight(i) is the estimated cost of task i
+   */
+  template <class Weight>
+  void makeChunks(size_t nbTasks, const Weight& weight) {
+    _taskWeights.resize(nbTasks);
+    double totalWeight = 0;
+    for (size_t i = 0; i < nbTasks; i++) {
+      _taskWeights[i] = weight(i);
+      totalWeight += _taskWeights[i];
+    }
+
+    double chunkWeight = totalWeight / (CHUNKS_PER_THREAD * getNbThreads());
+    _chunkStarts.assign(1, 0);
+    double currentWeight = 0;
+    for (size_t i = 0; i < nbTasks; i++) {
+      currentWeight += _taskWeights[i];
+      if (currentWeight >= chunkWeight) {
+        _chunkStarts.push_back(i + 1);
+        currentWeight = 0;
+      }
+    }
+    if (_chunkStarts.back() != nbTasks) _chunkStarts.push_back(nbTasks);
+    dealChunks();
+  }
+
+  /**
+   * @brief Takes the next chunk of a thread, from its deque
+   *        or stolen from another one
+   * @param thread
+   * @param first first task of the chunk
+   * @param last last task of the chunk (excluded)
+   * @return false if every chunk has been taken
+   */
+  bool takeChunk(size_t thread, size_t& first, size_t& last);
+
+  /**
+   * @brief Runs body(first, last, thread) on chunks of tasks
+   *        0 to nbTasks - 1 of about the same weight, balanced
+   *        between the threads by work stealing
+   * @param nbTasks
+   * @param weight weight(i) is the estimated cost of task i
+   * @param body
+   */
+  template <class Weight, class Body>
+  void parallelForWeighted(size_t nbTasks, const Weight& weight,
+                           const Body& body) {
+    makeChunks(nbTasks, weight);
+    run([&](size_t thread) {
+      size_t first, last;
+      while (takeChunk(thread, first, last)) body(first, last, thread);
+    });
+  }
+};
+
+#endif  // _THREAD_POOL_HPP_
@@ -0,0 +1,255 @@
+/**
+ * @file trajectory.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Binary trajectory file of the past states of a universe,
+ *        indexed by frame
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _TRAJECTORY_HPP_
+#define _TRAJECTORY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "particle_store.hpp"
+#include "thread_pool.hpp"
+#include "trajectory_codec.hpp"
+
+/**
+ * @brief Writes the frames of a trajectory file,
+ *        whose layout is (native byte order):
+ *
+ *        header   magic "PTRJ", version, dimension D,
+ *                 number of values per particle (D + 1),
+ *                 number of frames, offset of the index,
+ *                 whether frames are compressed, particles of a
+ *                 block, frames between key frames, precisions
+ *                 of the positions and of the forces, origin
+ *        frames   number of particles n, time,
+ *                 then n records of D + 1 doubles:
+ *                 the position and the norm of the force
+ *        index    for each frame, its offset, its number
+ *                 of particles and its time
+ *
+ *        Records of a frame have a fixed size, so a frame can be read
+ *        (or plotted by gnuplot with binary skip=... record=...)
+ *        directly from its offset. The index and the header are
+ *        written when the file is closed; a file which has not been
+ *        closed is indexed by reading the header of each frame.
+ *
+ *        With a TrajectoryCodec, the records of a frame are replaced
+ *        by the size of the compressed frame, whether it is a key
+ *        frame, then the size and the bytes of each block.
+ */
+class TrajectoryWriter {
+ public:
+  static constexpr char MAGIC[4] = {'P', 'T', 'R', 'J'};
+  static constexpr uint32_t VERSION = 2;
+
+  /* Magic, version, dimension, values per particle, number
+     of frames, offset of the index, then the codec */
+  static constexpr size_t HEADER_SIZE = sizeof(MAGIC) +
+                                        5 * sizeof(uint32_t) +
+                                        3 * sizeof(uint64_t) +
+                                        5 * sizeof(double);
+
+  /* Number of particles and time */
+  static constexpr size_t FRAME_HEADER_SIZE =
+      sizeof(uint64_t) + sizeof(double);
+
+ private:
+  std::ofstream _file;
+  size_t _dimension;
+
+  struct IndexEntry {
+    uint64_t offset;
+    uint64_t nbParticles;
+    double time;
+  };
+  std::vector<IndexEntry> _index;
+
+  /* Records of the frame being written */
+  std::vector<double> _buffer;
+  std::vector<double> _forceNorms;
+
+  /* Compression: rounded values of the frame and of the previous
+     one, column by column, and the compressed blocks */
+  std::optional<TrajectoryCodec> _codec;
+  std::unique_ptr<ThreadPool> _pool;
+  std::vector<int64_t> _quantized;
+  std::vector<int64_t> _previous;
+  std::vector<std::string> _blocks;
+
+  /**
+   * @brief Writes the compressed frame of positions and forceNorms
+   * @param positions
+   * @param forceNorms
+   */
+  void writeCompressedFrame(const std::vector<Vector>& positions,
+                            const std::vector<double>& forceNorms);
+
+  /**
+   * @brief Writes the header, with the number of frames
+   *        and the offset of the index
+   * @param indexOffset 0 while the index is not written
+   */
+  void writeHeader(uint64_t indexOffset);
+
+ public:
+  /**
+   * @brief Create the file fileName (replaced if it exists)
+   *        and writes its header
+   * @param fileName
+   * @param dimension 1, 2 or 3
+   */
+  TrajectoryWriter(const std::string& fileName, size_t dimension);
+
+  /**
+   * @brief Create the file fileName (replaced if it exists),
+   *        whose frames are compressed by codec
+   * @param fileName
+   * @param dimension 1, 2 or 3
+   * @param codec
+   */
+  TrajectoryWriter(const std::string& fileName, size_t dimension,
+                   const TrajectoryCodec& codec);
+
+  ~TrajectoryWriter();
+
+  TrajectoryWriter(const TrajectoryWriter&) = delete;
+  TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+  size_t getNbFrames() const { return _index.size(); }
+
+  /**
+   * @brief Appends a frame: positions and norms of the forces
+   *        of the particles
+   * @param particles
+   * @param time
+   */
+  void writeFrame(const ParticleStore& particles, double time);
+
+  /**
+   * @brief Appends a frame
+   * @param positions positions of the particles
+   * @param forceNorms norms of the forces applied on them
+   * @param time
+   */
+  void writeFrame(const std::vector<Vector>& positions,
+                  const std::vector<double>& forceNorms, double time);
+
+  /**
+   * @brief Writes the frames buffered so far in the file,
+   *        which can be read without its index
+   */
+  void flush();
+
+  /**
+   * @brief Writes the index and closes the file
+   *        (done by the destructor otherwise)
+   */
+  void close();
+};
+
+/**
+ * @brief Reads the frames of a trajectory file in any order
+ */
+class TrajectoryReader {
+ private:
+  std::string _fileName;
+  mutable std::ifstream _file;
+  size_t _dimension;
+  size_t _nbValues;
+
+  std::vector<uint64_t> _offsets;
+  std::vector<uint64_t> _nbParticles;
+  std::vector<double> _times;
+
+  /* Compression, and the last frame decoded
+     (rounded values, column by column) */
+  std::optional<TrajectoryCodec> _codec;
+  size_t _blockSize = 0;
+  mutable size_t _decodedFrame = SIZE_MAX;
+  mutable std::vector<int64_t> _decoded;
+
+  /**
+   * @brief Indexes the frames of a file which has not been closed
+   * @param fileSize
+   */
+  void scanFrames(uint64_t fileSize);
+
+  /**
+   * @brief Whether a compressed frame is a key frame
+   * @param frame
+   * @return bool
+   */
+  bool isKeyFrame(size_t frame) const;
+
+  /**
+   * @brief Decodes a compressed frame in _decoded, which holds
+   *        the previous frame if it is not a key frame
+   * @param frame
+   */
+  void decodeFrame(size_t frame) const;
+
+ public:
+  /**
+   * @brief Opens a trajectory file, throws std::runtime_error
+   *        if it is not a trajectory file
+   * @param fileName
+   */
+  explicit TrajectoryReader(const std::string& fileName);
+
+  const std::string& getFileName() const { return _fileName; }
+  size_t getDimension() const { return _dimension; }
+  size_t getNbFrames() const { return _offsets.size(); }
+  bool isCompressed() const { return _codec.has_value(); }
+
+  /**
+   * @brief Get the codec of a compressed file
+   * @return const TrajectoryCodec&
+   */
+  const TrajectoryCodec& getCodec() const { return *_codec; }
+
+  size_t getNbParticles(size_t frame) const;
+  double getTime(size_t frame) const;
+
+  /**
+   * @brief Offset in the file of the first record of a frame
+   *        (uncompressed files only)
+   * @param frame
+   * @return uint64_t
+   */
+  uint64_t getRecordsOffset(size_t frame) const;
+
+  /**
+   * @brief Reads a frame. A compressed frame is decoded from the
+   *        previous key frame, or from the last frame read if
+   *        it is between them (reading frames in order).
+   * @param frame
+   * @param positions positions of the particles
+   * @param forceNorms norms of the forces applied on them
+   */
+  void readFrame(size_t frame, std::vector<Vector>& positions,
+                 std::vector<double>& forceNorms) const;
+
+  /**
+   * @brief gnuplot binary clause reading the records of a frame
+   *        from the file, for instance
+   *        binary skip=48 record=100 format='%double%double%double'
+   *        with the columns of the position then of the force norm.
+   *        Throws std::runtime_error if the file is compressed.
+   * @param frame
+   * @return std::string
+   */
+  std::string getGnuplotBinary(size_t frame) const;
+};
+
+#endif  // _TRAJECTORY_HPP_
@@ -0,0 +1,139 @@
+/**
+ * @file trajectory_codec.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Lossy compression of the frames of a trajectory file
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _TRAJECTORY_CODEC_HPP_
+#define _TRAJECTORY_CODEC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "vector.hpp"
+
+/**
+ * @brief Compression of the frames of a trajectory file:
+ *
+ *        - positions are rounded to a multiple of a precision from
+ *          an origin (the lower bound of a FiniteUniverse), force
+ *          norms to a multiple of their own precision, so that the
+ *          error is at most half of the precision;
+ *        - frames are stored as the difference with the previous
+ *          frame (same number of particles), except a key frame every
+ *          few frames, so that a frame is decoded from at most that
+ *          many frames;
+ *        - particles of a frame are cut in blocks, compressed
+ *          independently (by several threads): the differences of a
+ *          column follow each other, zigzag encoded (small negative
+ *          values become small integers), on 4 or 8 bytes, whose
+ *          bytes are shuffled (all first bytes, then all second
+ *          bytes...) and compressed by a small LZ77 coder, which
+ *          turns the many zero bytes into a few matches.
+ */
+class TrajectoryCodec {
+ public:
+  /* Particles of a block */
+  static constexpr size_t BLOCK_SIZE = 4096;
+
+ private:
+  double _positionPrecision;
+  double _forcePrecision;
+  Vector _origin;
+  size_t _keyInterval = 64;
+  size_t _nbThreads = 1;
+
+ public:
+  /**
+   * @brief Create a codec
+   * @param positionPrecision step of the positions, > 0
+   * @param forcePrecision step of the norms of the forces, > 0
+   */
+  TrajectoryCodec(double positionPrecision, double forcePrecision);
+
+  double getPositionPrecision() const { return _positionPrecision; }
+  double getForcePrecision() const { return _forcePrecision; }
+
+  /**
+   * @brief Set the origin from which positions are rounded
+   * @param origin 0 by default
+   */
+  void setOrigin(const Vector& origin) { _origin = origin; }
+  const Vector& getOrigin() const { return _origin; }
+
+  /**
+   * @brief Set the number of frames between two key frames
+   * @param keyInterval 64 by default, at least 1
+   */
+  void setKeyInterval(size_t keyInterval);
+  size_t getKeyInterval() const { return _keyInterval; }
+
+  /**
+   * @brief Set the number of threads compressing the blocks
+   *        of a frame
+   * @param nbThreads 1 by default, 0 for the number of cores
+   */
+  void setNbThreads(size_t nbThreads) { _nbThreads = nbThreads; }
+  size_t getNbThreads() const { return _nbThreads; }
+
+  /**
+   * @brief Rounded coordinate d of a position
+   * @param coordinate
+   * @param d
+   * @return int64_t
+   */
+  int64_t quantizePosition(double coordinate, size_t d) const;
+  double dequantizePosition(int64_t quantized, size_t d) const;
+
+  /**
+   * @brief Rounded norm of a force
+   * @param norm
+   * @return int64_t
+   */
+  int64_t quantizeForce(double norm) const;
+  double dequantizeForce(int64_t quantized) const;
+
+  /**
+   * @brief Appends to data a block of values
+   * @param values
+   * @param nbValues
+   * @param data
+   */
+  static void compressBlock(const int64_t* values, size_t nbValues,
+                            std::string& data);
+
+  /**
+   * @brief Decodes a block, throws std::runtime_error if it is corrupted
+   * @param data
+   * @param size size of the block in data
+   * @param values nbValues values decoded
+   * @param nbValues
+   */
+  static void decompressBlock(const char* data, size_t size, int64_t* values,
+                              size_t nbValues);
+
+  /**
+   * @brief Appends size bytes compressed by the LZ77 coder to data
+   * @param bytes
+   * @param size
+   * @param data
+   */
+  static void compressLZ(const uint8_t* bytes, size_t size,
+                         std::string& data);
+
+  /**
+   * @brief Decodes bytes compressed by the LZ77 coder,
+   *        throws std::runtime_error if they are corrupted
+   * @param data
+   * @param size
+   * @param bytes decoded bytes
+   */
+  static void decompressLZ(const char* data, size_t size,
+                           std::vector<uint8_t>& bytes);
+};
+
+#endif  // _TRAJECTORY_CODEC_HPP_
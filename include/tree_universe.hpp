@@ -0,0 +1,69 @@
+/**
+ * @file tree_universe.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief A universe computing gravitation with a Barnes-Hut tree
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _TREE_UNIVERSE_HPP_
+#define _TREE_UNIVERSE_HPP_
+
+#include <vector>
+
+#include "barnes_hut_tree.hpp"
+#include "universe.hpp"
+
+/**
+ * @brief Universe where gravitation between all the particles is
+ *        approximated with a Barnes-Hut tree, rebuilt at each step:
+ *        O(n log n) instead of O(n²) for every pair.
+ *
+ *        Only gravitational interactions without cut-off radius
+ *        (makeGravitationalInteraction()) are computed with the tree,
+ *        other interactions are still computed on every pair.
+ */
+class TreeUniverse : public Universe {
+ private:
+  BarnesHutTree _tree;
+
+  /* Interactions not computed with the tree */
+  std::vector<Interaction> _pairwiseInteractions;
+
+  /**
+   * @brief Tells if an interaction is computed with the tree
+   * @param interaction
+   * @return bool
+   */
+  static bool isTreeInteraction(const Interaction& interaction);
+
+ protected:
+  /**
+   * @brief Builds the tree and applies gravitation with it,
+   *        then applies the other interactions on every pair
+   */
+  void applyInteractionForces() override;
+
+ public:
+  /**
+   * @brief Constructor of class TreeUniverse
+   * @param dimension Universe dimension (1D, 2D or 3D)
+   * @param openingAngle θ, see BarnesHutTree::setOpeningAngle
+   */
+  TreeUniverse(size_t dimension, double openingAngle = 0.5);
+
+  /**
+   * @brief Get the tree of the last step
+   * @return const BarnesHutTree&
+   */
+  const BarnesHutTree& getTree() const { return _tree; }
+
+  void setOpeningAngle(double openingAngle) {
+    _tree.setOpeningAngle(openingAngle);
+  }
+  void setSoftening(double softening) { _tree.setSoftening(softening); }
+  void setQuadrupole(bool quadrupole) { _tree.setQuadrupole(quadrupole); }
+  void setLeafSize(size_t leafSize) { _tree.setLeafSize(leafSize); }
+};
+
+#endif  // _TREE_UNIVERSE_HPP_
@@ -10,13 +10,24 @@
 #define _UNIVERSE_HPP_
 
 #include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
-#include "cell.hpp"
+#include "dimension_kernels.hpp"
 #include "external_force.hpp"
+#include "integrator.hpp"
 #include "interraction.hpp"
+#include "output_schedule.hpp"
+#include "pair_batch.hpp"
 #include "particle.hpp"
+#include "particle_store.hpp"
+#include "thread_pool.hpp"
+#include "trajectory_codec.hpp"
 #include "vector.hpp"
+#include "vtk_writer.hpp"
 
 /**
  * @class Universe
@@ -27,46 +38,95 @@ class Universe {
  private:
   size_t _dimension;  // Dimension of the universe
 
-  /* Store in list (doubly linked list) because
-     particles of the universe will be deleted
-     if they quit the GriddedUniverse domain.
-     So we need constant time complexity
-     for deletion. Plus we will never try to reach
-     only one particle in the list, we will always
-     iterate through all of them. */
-  std::list<Particle> _particles;
+  /* Loops over particles compiled for the dimension
+     of the universe, chosen at construction */
+  const DimensionKernels& _kernels;
+
+  /* Store in contiguous columns (structure of arrays) because
+     we always iterate through all the particles, field by field.
+     Particles quitting a FiniteUniverse domain are removed
+     all at once by compacting the columns, in linear time. */
+  ParticleStore _particles;
 
   /* past particles in the universe */
   size_t _nbPastStates = 0;
-  const char* _pastParticlesFileName = "pastParticles.txt";
+  std::string _pastParticlesFileName = "pastParticles.trj";
+
+  /* Compression of the past particles file, none by default */
+  std::optional<TrajectoryCodec> _trajectoryCodec;
+
+  /* Encoding of the VTK files (XML_OUTPUT) */
+  VtkEncoding _vtkEncoding = RAW;
+
+  /* Steps written by the outputs, and number of frames
+     written by the last simulation */
+  OutputSchedule _outputSchedule = makeEveryStepSchedule();
+  size_t _nbWrittenFrames = 0;
+
+  /* Scheme of a time step, velocity Verlet (Störmer-Verlet)
+     by default */
+  Integrator _integrator = makeVelocityVerletIntegrator();
 
   /* list of interactions between particles.
      For exemple can contain gravitational interraction
      and Lennard Jones interraction. */
-  std::list<Interaction> _interactions;
+  std::vector<Interaction> _interactions;
+
+  /* Multiple time stepping (r-RESPA): each interaction and external
+     force has a time-scale level. Level 0 makes steps of the time step
+     of the simulation, level l + 1 makes _subSteps[l] steps during a
+     step of level l. Forces of a level are only computed at the end
+     of its steps, with the interactions of _levelInteractions. */
+  static constexpr size_t ALL_LEVELS = std::numeric_limits<size_t>::max();
+  std::vector<size_t> _subSteps;
+  std::vector<size_t> _interactionLevels;
+  std::vector<size_t> _forceLevels;
+  std::vector<std::vector<Interaction>> _levelInteractions;
+  size_t _activeLevel = ALL_LEVELS;
+
+  /* Block time steps: particle i makes steps of the time step of
+     the simulation divided by 2^_blockLevels[i] (at most
+     2^_maxBlockLevel), chosen from its acceleration and jerk.
+     Only the forces of the particles ending a step (active
+     particles) are computed. 0 (default) disables them.
+     Forces at the start of their step estimate the jerk. */
+  size_t _maxBlockLevel = 0;
+  double _blockAccuracy = 0.02;
+  std::vector<size_t> _blockLevels;
+  std::vector<Vector> _previousForces;
+  std::vector<size_t> _activeParticles;
+
+  /* buffers to compute interactions by batches of pairs */
+  PairBatch _pairBatch;
+
+  /* Threads of the simulation steps (the calling one only by
+     default). In the force phase each thread has its own batch
+     and force buffer, summed at the end. */
+  std::shared_ptr<ThreadPool> _threadPool;
+  std::vector<PairBatch> _threadBatches;
+  std::vector<std::vector<Vector>> _threadForces;
 
   /* list of forces applied on any particle
      (not an interaction).
      For exemple the gravition field. */
-  std::list<ExternalForce> _forces;
+  std::vector<ExternalForce> _forces;
+
+  /* During a Störmer-Verlet step, updatePositions also kicks the
+     particles and resets the forces to the uniform fields (sum of
+     the gravity fields of the external forces), in the same sweep
+     as the drift and the extremum values: updateForces then only
+     adds the others */
+  bool _fusedStep = false;
+  Vector _uniformField;
 
   // Extremum values that particles had been into
   Vector _minPosition;
   Vector _maxPosition;
-  double _maxForce;
+  double _maxForce = 0;
 
   /* Cinetic energy limit for the system, c.f. TP6
      Avoid speed divergence of particles */
   double _cineticEnergyLimit = 100000;
-<<<<<<< HEAD
-=======
-
-  /**
-   * @brief Applies forces between particles in the universe.
-   *        Quadratic complexity.
-   */
-  virtual void applyInteractionForces();
->>>>>>> 22b10cc0c87503308962e9d792e920a26a3dc432
 
   /**
    * @brief Set all forces applied on particles
@@ -74,6 +134,125 @@ class Universe {
    */
   void setForcesToZero();
 
+  /**
+   * @brief updates extremum values such as positions and force
+   */
+  void updatesExtremumValues();
+
+  /**
+   * @brief Updates particles paces (last kick)
+   *        in Stormer Verlet algorithm, and limits the cinetic
+   *        energy summed in the same sweep
+   */
+  void updatePaces(double timeStep);
+
+  /**
+   * @brief Slows down particles if the cinetic energy
+   *        is above its limit
+   * @param cineticEnergy current cinetic energy
+   */
+  void limitCineticEnergy(double cineticEnergy);
+
+  /**
+   * @brief Sums the gravity fields of the external forces
+   *        into the uniform field
+   */
+  void updateUniformField();
+
+  /**
+   * @brief One step of the Störmer-Verlet method, as velocity Verlet
+   *        (kick drift kick): a single sweep kicks and moves particles
+   *        and resets their forces, forces are computed, and a single
+   *        sweep kicks again and sums the cinetic energy. Only the
+   *        forces of the current positions are needed.
+   * @param timeStep
+   */
+  void stormerVerletStep(double timeStep);
+
+  /**
+   * @brief Sorts interactions by level, and computes
+   *        the forces of every level
+   */
+  void startMultipleTimeStepping();
+
+  /**
+   * @brief Computes the forces of the interactions and
+   *        external forces of a level only, in its column
+   * @param level
+   */
+  void updateLevelForces(size_t level);
+
+  /**
+   * @brief Sets the forces of the particles to the sum of the
+   *        forces of every level (extremum values and output)
+   */
+  void sumLevelForces();
+
+  /**
+   * @brief Adds to speeds the impulse of the forces of a level
+   * @param level
+   * @param timeStep
+   */
+  void kick(size_t level, double timeStep);
+
+  /**
+   * @brief One step of a level (r-RESPA): half kick of its forces,
+   *        steps of the next level (or a drift for the last level),
+   *        then its forces are computed and another half kick
+   * @param level
+   * @param timeStep
+   */
+  void multipleTimeStep(size_t level, double timeStep);
+
+  /**
+   * @brief One step of the integrator of the universe (other than
+   *        velocity Verlet): its kicks and drifts in turn, forces
+   *        being computed before a kick if particles drifted
+   * @param timeStep
+   * @param forcesUpToDate whether forces are those of the current
+   *                       positions, updated by the step
+   */
+  void compositionStep(double timeStep, bool& forcesUpToDate);
+
+  /**
+   * @brief Computes the forces of every particle, which all
+   *        start with the shortest block time step
+   */
+  void startBlockTimeSteps();
+
+  /**
+   * @brief Computes the forces on the active particles only:
+   *        their external forces, and the interactions of
+   *        every particle on them
+   */
+  void applyActiveForces();
+
+  /**
+   * @brief Chooses the level of the next step of a particle which
+   *        ended a step, from the change of its force during this
+   *        step (|a| / |jerk| time scale). A particle can move to a
+   *        longer step only if it starts at a multiple of it.
+   * @param i particle
+   * @param timeStep time step of the simulation
+   * @param tick number of shortest steps done since the start
+   *             of the time step of the simulation
+   */
+  void chooseBlockLevel(size_t i, double timeStep, size_t tick);
+
+  /**
+   * @brief One time step of the simulation with block time steps
+   *        (kick drift kick on the steps of each particle): every
+   *        particle drifts on each shortest step, particles starting
+   *        or ending a step are kicked
+   * @param timeStep
+   */
+  void blockTimeStep(double timeStep);
+
+  /* Friend class access private fields for
+     universe visualisation */
+  friend class VisualGenerator;
+
+ protected:
   /**
    * @brief Calculates the current cinetic energy of the system.
    *        Half the sum of the particles masses times their speed norm squared.
@@ -83,26 +262,105 @@ class Universe {
   double currentCineticEnergy() const;
 
   /**
-   * @brief updates extremum values such as positions and force
+   * @brief Cinetic energy of the system, from the one of
+   *        the particles of the universe
+   * @param cineticEnergy
+   * @return double
    */
-  void updatesExtremumValues();
+  virtual double sumCineticEnergy(double cineticEnergy) const {
+    return cineticEnergy;
+  }
 
   /**
-   * @brief Updates particles paces
-   *        in Stormer Verlet algorithm
+   * @brief Set the name of the file where past particles are written
+   * @param fileName
    */
-  void updatePaces(double timeStep);
+  void setPastParticlesFileName(const std::string& fileName) {
+    _pastParticlesFileName = fileName;
+  }
 
-  /* Friend class access private fields for
-     universe visualisation */
-  friend class VisualGenerator;
+  /**
+   * @brief Get the store of particles
+   * @return ParticleStore&
+   */
+  ParticleStore& getParticles() { return _particles; }
+  const ParticleStore& getParticles() const { return _particles; }
+
+  /**
+   * @brief Get the kernels specialized for the universe dimension
+   * @return const DimensionKernels&
+   */
+  const DimensionKernels& getKernels() const { return _kernels; }
 
- protected:
   /**
-   * @brief Get list of particles reference
-   * @return std::list<Particle>&
+   * @brief Get the buffers used to compute interactions
+   *        by batches of pairs
+   * @return PairBatch&
    */
-  std::list<Particle>& getParticles() { return _particles; }
+  PairBatch& getPairBatch() { return _pairBatch; }
+
+  /**
+   * @brief Get the threads of the simulation steps
+   * @return ThreadPool* nullptr if the universe has one thread
+   */
+  ThreadPool* getThreadPool() { return _threadPool.get(); }
+
+  /**
+   * @brief Get the interactions of the forces being computed:
+   *        those of the current level with multiple time
+   *        stepping, all of them otherwise
+   * @return const std::vector<Interaction>&
+   */
+  const std::vector<Interaction>& getActiveInteractions() const {
+    return _activeLevel == ALL_LEVELS ? _interactions
+                                      : _levelInteractions[_activeLevel];
+  }
+
+  /**
+   * @brief Tells if the forces of a level are being computed
+   *        (always true without multiple time stepping)
+   * @param level
+   * @return bool
+   */
+  bool isLevelActive(size_t level) const {
+    return _activeLevel == ALL_LEVELS || _activeLevel == level;
+  }
+
+  /**
+   * @brief Whether runForceTasks uses several threads: more than
+   *        one thread is set, and every interaction is built-in
+   *        (other interactions apply their forces directly on
+   *        the particles, through their functions)
+   * @return bool
+   */
+  bool isForcePhaseParallel() const;
+
+  /**
+   * @brief Runs the tasks 0 to nbTasks - 1 of the force phase.
+   *        task(i, batch, forces) must compute task i with the batch
+   *        given, and add the forces to the buffer given (indexed
+   *        like the particles). With several threads, tasks are
+   *        cut in chunks of about the same weight, balanced between
+   *        the threads by work stealing, each thread with its own
+   *        batch and buffer. Buffers are then summed into the
+   *        particles forces. Otherwise the buffer is the forces
+   *        of the particles.
+   * @param nbTasks
+   * @param weight weight(i) is the estimated cost of task i
+   *               (number of pairs for instance)
+   * @param task
+   */
+  template <class Weight, class Task>
+  void runForceTasks(size_t nbTasks, const Weight& weight, const Task& task);
+
+  /**
+   * @brief Runs body(first, last) on blocks of particles
+   *        covering all the particles, on the threads of
+   *        the universe (linear loops such as integration)
+   * @param body
+   */
+  template <class Body>
+  void runParticleBlocks(const Body& body);
 
   /**
    * @brief Get the bounds of the universe,
@@ -113,16 +371,17 @@ class Universe {
   virtual std::pair<Vector, Vector> getBounds() const;
 
   /**
-   * @brief Get the Last Particle Pointer
-   *        Useful in the method addParticle
-   *        of GriddedUniverse
-   * @return Particle*
+   * @brief Get a handle on the last added particle
+   * @return Particle
    */
-  Particle* getLastAddedParticlePointer() { return &_particles.back(); }
+  Particle getLastAddedParticle() {
+    return _particles.at(_particles.size() - 1);
+  }
 
   /**
-   * @brief Updates particles positions
-   *        in Stormer Verlet algorithm
+   * @brief Moves particles at constant speed (drift). In a step of
+   *        the Stormer Verlet algorithm, the first kick is done in
+   *        the same sweep.
    */
   virtual void updatePositions(double timeStep);
 
@@ -144,6 +403,13 @@ class Universe {
    */
   virtual void applyInteractionForces();
 
+  /**
+   * @brief Applies the forces of some interactions between
+   *        every pair of particles. Quadratic complexity.
+   * @param interactions
+   */
+  void applyPairwiseForces(const std::vector<Interaction>& interactions);
+
  public:
   /**
    * @brief Constructor of class Universe
@@ -160,9 +426,9 @@ class Universe {
 
   /**
    * @brief Get the universe interactions
-   * @return const std::list<Interaction>&
+   * @return const std::vector<Interaction>&
    */
-  const std::list<Interaction>& getInteractions() const {
+  const std::vector<Interaction>& getInteractions() const {
     return _interactions;
   }
 
@@ -230,12 +496,153 @@ class Universe {
   void addInteraction(
       std::function<void(const Particle&, Particle&)> interactionFunction);
 
+  /**
+   * @brief Adds an interaction between particles in the universe
+   *        (with its cut-off radius, if any)
+   * @param interaction
+   * @param level time-scale level, see setSubSteps
+   */
+  void addInteraction(const Interaction& interaction, size_t level = 0);
+
+  /**
+   * @brief Adds interaction between two particles
+   *        in the universe, that respects Newton's third law.
+   *        The pair function must apply at once the force
+   *        on both particles given, so that each pair
+   *        of particles is computed only once.
+   * @param interactionFunction
+   * @param pairFunction
+   */
+  void addInteraction(
+      std::function<void(const Particle&, Particle&)> interactionFunction,
+      std::function<void(Particle&, Particle&)> pairFunction);
+
+  /**
+   * @brief Adds force on particles in the universe
+   *        (makeGravitationalForce for instance)
+   * @param force
+   * @param level time-scale level, see setSubSteps
+   */
+  void addExternalForce(const ExternalForce& force, size_t level = 0);
+
   /**
    * @brief Adds force on particles in the universe.
    * @param forceFunction
    */
   void addExternalForce(std::function<void(Particle&)> forceFunction);
 
+  /**
+   * @brief Sets the time-scale levels of multiple time stepping
+   *        (r-RESPA). Level 0 makes steps of the time step of the
+   *        simulation, level l + 1 makes subSteps[l] steps during
+   *        a step of level l. Stiff and cheap forces go on the last
+   *        levels, slow and expensive ones on the first levels,
+   *        to be computed less often. The integration stays
+   *        symplectic and time reversible. No sub step (default)
+   *        is the Störmer-Verlet method.
+   * @param subSteps at least 1 each
+   */
+  void setSubSteps(const std::vector<size_t>& subSteps);
+
+  /**
+   * @brief Get the number of time-scale levels
+   * @return size_t
+   */
+  size_t getNbLevels() const { return _subSteps.size() + 1; }
+
+  /**
+   * @brief Sets the integrator of the time steps
+   *        (makeYoshida4Integrator for instance). Multiple time
+   *        stepping and block time steps need velocity Verlet.
+   * @param integrator velocity Verlet by default
+   */
+  void setIntegrator(const Integrator& integrator) {
+    _integrator = integrator;
+  }
+  const Integrator& getIntegrator() const { return _integrator; }
+
+  /**
+   * @brief Sets the encoding of the data of the VTK files
+   *        written with XML_OUTPUT
+   * @param encoding RAW by default, BASE64 for a text file
+   */
+  void setVtkEncoding(VtkEncoding encoding) { _vtkEncoding = encoding; }
+
+  /**
+   * @brief Compresses the past particles file (PNG_OUTPUT):
+   *        positions and norms of the forces are stored with an
+   *        error of at most half of their precision. Positions
+   *        are rounded from the lower bound of a FiniteUniverse.
+   * @param codec precisions, key frames and threads
+   */
+  void setTrajectoryCodec(const TrajectoryCodec& codec) {
+    _trajectoryCodec = codec;
+  }
+
+  /**
+   * @brief Sets the steps written by the outputs
+   *        (makeFrameCountSchedule for instance). Every step
+   *        is still simulated and counted in getNbPastStates.
+   * @param schedule every step by default
+   */
+  void setOutputSchedule(const OutputSchedule& schedule) {
+    _outputSchedule = schedule;
+  }
+  const OutputSchedule& getOutputSchedule() const { return _outputSchedule; }
+
+  /**
+   * @brief Number of frames written by the outputs
+   *        during the last simulation
+   * @return size_t
+   */
+  size_t getNbWrittenFrames() const { return _nbWrittenFrames; }
+
+  /**
+   * @brief Sets individual block time steps: each particle makes
+   *        steps of the time step of the simulation divided by a
+   *        power of 2 (at most 2^maxLevel), so that its step is at
+   *        most accuracy * |a| / |jerk|. Close or fast particles take
+   *        short steps without slowing down the others, as only the
+   *        forces on the particles ending a step are computed.
+   *        Interactions are computed on every pair, as in Universe.
+   *        Not supported with multiple time stepping
+   *        nor by finite universes.
+   * @param maxLevel 0 (default) for a single time step
+   * @param accuracy 0.02 by default
+   */
+  void setBlockTimeSteps(size_t maxLevel, double accuracy = 0.02);
+
+  /**
+   * @brief Get the maximum level of the block time steps
+   * @return size_t 0 without block time steps
+   */
+  size_t getMaxBlockLevel() const { return _maxBlockLevel; }
+
+  /**
+   * @brief Get the levels of the block time steps of the particles:
+   *        particle i makes steps of timeStep / 2^levels[i]
+   * @return const std::vector<size_t>&
+   */
+  const std::vector<size_t>& getBlockLevels() const { return _blockLevels; }
+
+  /**
+   * @brief Sets the number of threads of the simulation steps
+   *        (interactions and integration). Threads are kept
+   *        between steps. Results may differ by rounding errors
+   *        from one run to another with several threads,
+   *        as the work is balanced dynamically.
+   * @param nbThreads 1 by default, 0 for the number of cores
+   */
+  void setNbThreads(size_t nbThreads);
+
+  /**
+   * @brief Get the number of threads of the simulation steps
+   * @return size_t
+   */
+  size_t getNbThreads() const {
+    return _threadPool ? _threadPool->getNbThreads() : 1;
+  }
+
   /**
    * @brief Renvoie le nombre de particules dans l'univers
    * @return Le nombre de particules dans l'univers
@@ -244,7 +651,7 @@ class Universe {
 
   /**
    * @brief Simulates the movement of particles in the universe using the
-   * Störmer-Verlet method
+   * Störmer-Verlet method, or the integrator set
    * @param timeStep
    * @param finalTime End time of the simulation
    */
@@ -269,4 +676,51 @@ class Universe {
   }
 };
 
+template <class Weight, class Task>
+void Universe::runForceTasks(size_t nbTasks, const Weight& weight,
+                             const Task& task) {
+  if (!isForcePhaseParallel()) {
+    std::vector<Vector>& forces = _particles.getForces();
+    for (size_t i = 0; i < nbTasks; i++) task(i, _pairBatch, forces);
+    return;
+  }
+
+  // Each thread clears its buffer, then adds the forces of its chunks
+  size_t nbParticles = _particles.size();
+  _threadPool->makeChunks(nbTasks, weight);
+  _threadPool->run([&](size_t thread) {
+    std::vector<Vector>& forces = _threadForces[thread];
+    forces.assign(nbParticles, Vector(_dimension));
+    PairBatch& batch = _threadBatches[thread];
+    size_t first, last;
+    while (_threadPool->takeChunk(thread, first, last)) {
+      for (size_t i = first; i < last; i++) task(i, batch, forces);
+    }
+  });
+
+  // Parallel reduction, each thread sums a block of particles
+  std::vector<Vector>& forces = _particles.getForces();
+  runParticleBlocks([&](size_t first, size_t last) {
+    for (const std::vector<Vector>& threadForces : _threadForces) {
+      for (size_t i = first; i < last; i++) forces[i] += threadForces[i];
+    }
+  });
+}
+
+template <class Body>
+void Universe::runParticleBlocks(const Body& body) {
+  size_t nbParticles = _particles.size();
+  if (!_threadPool) {
+    body(0, nbParticles);
+    return;
+  }
+
+  size_t nbThreads = _threadPool->getNbThreads();
+  size_t block = (nbParticles + nbThreads - 1) / nbThreads;
+  _threadPool->parallelFor(nbParticles, block,
+                           [&](size_t first, size_t last, size_t) {
+                             body(first, last);
+                           });
+}
+
 #endif  // _UNIVERSE_HPP_
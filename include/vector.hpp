@@ -9,36 +9,117 @@
 #ifndef _VECTOR_HPP_
 #define _VECTOR_HPP_
 
+#include <array>
+#include <cmath>
+#include <initializer_list>
 #include <ostream>
-#include <vector>
+
+#include "xassert.hpp"
+
+class Vector;
 
 /**
- * @brief Vector class
+ * @brief Base class of every vector expression (CRTP).
+ *        An expression such as a + b * 2 is not computed
+ *        when written, it is a light object that computes
+ *        its coordinates on demand. The computation happens
+ *        coordinate by coordinate when the expression is
+ *        assigned or added to a Vector, so chained arithmetic
+ *        does not create any temporary vector.
+ * @tparam E the derived expression type
  */
-class Vector {
+template <class E>
+class VectorExpression {
+ public:
+  double operator[](size_t index) const {
+    return static_cast<const E&>(*this)[index];
+  }
+  size_t getDimension() const {
+    return static_cast<const E&>(*this).getDimension();
+  }
+};
+
+/* Vectors are stored by reference in expressions,
+   sub-expressions (temporaries) are stored by value. */
+template <class E>
+struct ExpressionOperand {
+  using type = const E;
+};
+template <>
+struct ExpressionOperand<Vector> {
+  using type = const Vector&;
+};
+
+/**
+ * @brief Vector class.
+ *        Coordinates are stored in the object itself (no heap allocation),
+ *        the dimension can be at most MAX_DIMENSION.
+ */
+class Vector : public VectorExpression<Vector> {
+ public:
+  static constexpr size_t MAX_DIMENSION = 3;
+
  private:
+  std::array<double, MAX_DIMENSION> _data;
   size_t _dimension;
-  std::vector<double> _data;
 
  public:
   // Constructors
-  Vector(size_t size) : _dimension(size), _data(size, 0) {}
+  Vector(size_t size) : _data{0, 0, 0}, _dimension(size) {
+    xassert(size <= MAX_DIMENSION, "Vector dimension must be at most 3.");
+  }
   Vector() : Vector(0) {}
-  Vector(std::initializer_list<double> values)
-      : _dimension(values.size()), _data(values) {}
+  Vector(std::initializer_list<double> values) : Vector(values.size()) {
+    size_t i = 0;
+    for (double value : values) _data[i++] = value;
+  }
+
+  /**
+   * @brief Evaluates an expression into a new vector
+   * @param expression
+   */
+  template <class E>
+  Vector(const VectorExpression<E>& expression)
+      : Vector(expression.getDimension()) {
+    for (size_t i = 0; i < _dimension; ++i) _data[i] = expression[i];
+  }
 
   // Getters
   double& operator[](size_t index) { return _data[index]; }
   double operator[](size_t index) const { return _data[index]; }
-  const std::vector<double>& getData() const { return _data; }
+  const double* data() const { return _data.data(); }
+  const double* begin() const { return _data.data(); }
+  const double* end() const { return _data.data() + _dimension; }
   size_t getDimension() const { return _dimension; }
 
   // Calculations
   bool operator==(const Vector& other) const;
   bool operator!=(const Vector& other) const;
-  void operator+=(const Vector& other);
-  void operator-=(const Vector& other);
-  void operator*=(double scalar);
+
+  template <class E>
+  Vector& operator=(const VectorExpression<E>& expression) {
+    _dimension = expression.getDimension();
+    for (size_t i = 0; i < _dimension; ++i) _data[i] = expression[i];
+    return *this;
+  }
+
+  template <class E>
+  void operator+=(const VectorExpression<E>& expression) {
+    xassert(_dimension == expression.getDimension(),
+            "Vectors dimensions must match.");
+    for (size_t i = 0; i < _dimension; ++i) _data[i] += expression[i];
+  }
+
+  template <class E>
+  void operator-=(const VectorExpression<E>& expression) {
+    xassert(_dimension == expression.getDimension(),
+            "Vectors dimensions must match.");
+    for (size_t i = 0; i < _dimension; ++i) _data[i] -= expression[i];
+  }
+
+  void operator*=(double scalar) {
+    for (size_t i = 0; i < _dimension; ++i) _data[i] *= scalar;
+  }
 
   /**
    * @brief Tell for each dimension if the coords of the calling vector
@@ -58,22 +139,6 @@ class Vector {
    */
   bool isInBounds(const Vector& lowerBound, const Vector& upperBound) const;
 
-  /**
-   * @brief Returns vector with min on each coordinates
-   * @param v1
-   * @param v2
-   * @return Vector
-   */
-  friend Vector min(Vector v1, Vector v2);
-
-  /**
-   * @brief Returns vector with max on each coordinates
-   * @param v1
-   * @param v2
-   * @return Vector
-   */
-  friend Vector max(Vector v1, Vector v2);
-
   /**
    * @brief give the norm of the vector
    *        i.e. square root of sum of squares
@@ -81,6 +146,13 @@ class Vector {
    */
   double norm() const;
 
+  /**
+   * @brief give the squared norm of the vector
+   *        i.e. sum of squares (no square root)
+   * @return double
+   */
+  double squaredNorm() const;
+
   /**
    * @brief Overrides the << operator
    * @param strm
@@ -90,4 +162,150 @@ class Vector {
   friend std::ostream& operator<<(std::ostream& strm, const Vector& v);
 };
 
-#endif  // _VECTOR_HPP_
\ No newline at end of file
+/**
+ * @brief Expression applying a binary operation coordinate by coordinate
+ * @tparam L left operand expression
+ * @tparam R right operand expression
+ * @tparam Operation functor combining two coordinates
+ */
+template <class L, class R, class Operation>
+class VectorBinaryExpression
+    : public VectorExpression<VectorBinaryExpression<L, R, Operation>> {
+ private:
+  typename ExpressionOperand<L>::type _left;
+  typename ExpressionOperand<R>::type _right;
+
+ public:
+  VectorBinaryExpression(const L& left, const R& right)
+      : _left(left), _right(right) {
+    xassert(left.getDimension() == right.getDimension(),
+            "Vectors dimensions must match.");
+  }
+
+  double operator[](size_t index) const {
+    return Operation::apply(_left[index], _right[index]);
+  }
+  size_t getDimension() const { return _left.getDimension(); }
+};
+
+/**
+ * @brief Expression multiplying a vector expression by a scalar
+ * @tparam E
+ */
+template <class E>
+class VectorScaledExpression
+    : public VectorExpression<VectorScaledExpression<E>> {
+ private:
+  typename ExpressionOperand<E>::type _expression;
+  double _scalar;
+
+ public:
+  VectorScaledExpression(const E& expression, double scalar)
+      : _expression(expression), _scalar(scalar) {}
+
+  double operator[](size_t index) const { return _expression[index] * _scalar; }
+  size_t getDimension() const { return _expression.getDimension(); }
+};
+
+/* Coordinate operations used in binary expressions */
+struct VectorAddition {
+  static double apply(double a, double b) { return a + b; }
+};
+struct VectorSubtraction {
+  static double apply(double a, double b) { return a - b; }
+};
+struct VectorMinimum {
+  static double apply(double a, double b) { return (b < a) ? b : a; }
+};
+struct VectorMaximum {
+  static double apply(double a, double b) { return (b > a) ? b : a; }
+};
+
+template <class L, class R>
+VectorBinaryExpression<L, R, VectorAddition> operator+(
+    const VectorExpression<L>& left, const VectorExpression<R>& right) {
+  return VectorBinaryExpression<L, R, VectorAddition>(
+      static_cast<const L&>(left), static_cast<const R&>(right));
+}
+
+template <class L, class R>
+VectorBinaryExpression<L, R, VectorSubtraction> operator-(
+    const VectorExpression<L>& left, const VectorExpression<R>& right) {
+  return VectorBinaryExpression<L, R, VectorSubtraction>(
+      static_cast<const L&>(left), static_cast<const R&>(right));
+}
+
+template <class E>
+VectorScaledExpression<E> operator*(const VectorExpression<E>& expression,
+                                    double scalar) {
+  return VectorScaledExpression<E>(static_cast<const E&>(expression), scalar);
+}
+
+template <class E>
+VectorScaledExpression<E> operator*(double scalar,
+                                    const VectorExpression<E>& expression) {
+  return VectorScaledExpression<E>(static_cast<const E&>(expression), scalar);
+}
+
+/**
+ * @brief Returns vector with min on each coordinates
+ * @param v1
+ * @param v2
+ * @return expression of the vector
+ */
+template <class L, class R>
+VectorBinaryExpression<L, R, VectorMinimum> min(const VectorExpression<L>& v1,
+                                                const VectorExpression<R>& v2) {
+  return VectorBinaryExpression<L, R, VectorMinimum>(
+      static_cast<const L&>(v1), static_cast<const R&>(v2));
+}
+
+/**
+ * @brief Returns vector with max on each coordinates
+ * @param v1
+ * @param v2
+ * @return expression of the vector
+ */
+template <class L, class R>
+VectorBinaryExpression<L, R, VectorMaximum> max(const VectorExpression<L>& v1,
+                                                const VectorExpression<R>& v2) {
+  return VectorBinaryExpression<L, R, VectorMaximum>(
+      static_cast<const L&>(v1), static_cast<const R&>(v2));
+}
+
+/**
+ * @brief give the squared norm of a vector expression
+ * @param expression
+ * @return double
+ */
+template <class E>
+double squaredNorm(const VectorExpression<E>& expression) {
+  double sum = 0;
+  for (size_t i = 0; i < expression.getDimension(); ++i)
+    sum += expression[i] * expression[i];
+  return sum;
+}
+
+/**
+ * @brief give the norm of a vector expression
+ * @param expression
+ * @return double
+ */
+template <class E>
+double norm(const VectorExpression<E>& expression) {
+  return std::sqrt(squaredNorm(expression));
+}
+
+template <class L, class R>
+bool operator==(const VectorExpression<L>& left,
+                const VectorExpression<R>& right) {
+  return Vector(left) == Vector(right);
+}
+
+template <class E>
+std::ostream& operator<<(std::ostream& strm,
+                         const VectorExpression<E>& expression) {
+  return strm << Vector(expression);
+}
+
+#endif  // _VECTOR_HPP_
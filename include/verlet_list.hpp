@@ -0,0 +1,115 @@
+/**
+ * @file verlet_list.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Lists of the pairs of close particles, kept between steps
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _VERLET_LIST_HPP_
+#define _VERLET_LIST_HPP_
+
+#include <vector>
+
+#include "cell_list.hpp"
+#include "particle_store.hpp"
+#include "vector.hpp"
+
+/**
+ * @brief Neighbours of particles, in compressed arrays (CSR):
+ *        row r gives the neighbours of particle particles[r],
+ *        from neighbours[start[r]] to neighbours[start[r + 1] - 1].
+ *        Particles without neighbours have no row.
+ */
+struct NeighbourRows {
+  std::vector<size_t> particles;
+  std::vector<size_t> start = {0};
+  std::vector<size_t> neighbours;
+
+  size_t size() const { return particles.size(); }
+  size_t getNbPairs() const { return neighbours.size(); }
+
+  IndexSpan getNeighbours(size_t row) const {
+    return IndexSpan(neighbours.data() + start[row],
+                     neighbours.data() + start[row + 1]);
+  }
+
+  void clear() {
+    particles.clear();
+    start.assign(1, 0);
+    neighbours.clear();
+  }
+
+  /**
+   * @brief Ends the row of a particle, whose neighbours were
+   *        added since the last row (no row if there are none)
+   * @param particle
+   */
+  void endRow(size_t particle) {
+    if (neighbours.size() == start.back()) return;
+    particles.push_back(particle);
+    start.push_back(neighbours.size());
+  }
+};
+
+/**
+ * @brief Verlet list: pairs of particles closer than the cut-off
+ *        radius plus a skin, built with the cells.
+ *        While no particle has moved by more than half of the skin
+ *        since the list was built, no pair closer than the cut-off
+ *        radius can be missing, so the list is reused
+ *        instead of going through the cells at each step.
+ */
+class VerletList {
+ private:
+  double _cutoff;
+  double _skin;
+
+  /* Neighbours of particles of the universe, each pair once */
+  NeighbourRows _rows;
+
+  /* Ghosts neighbours of particles of the universe,
+     for PERIODIC universes */
+  NeighbourRows _ghostRows;
+
+  /* Positions when the list was built */
+  std::vector<Vector> _referencePositions;
+
+  size_t _nbBuilds = 0;
+
+ public:
+  /**
+   * @brief Creates an empty list, built at the first step
+   * @param cutoff distance with which we can neglect interractions
+   * @param skin extra distance, the larger the less often the list is
+   *             rebuilt, but the more pairs it has
+   */
+  VerletList(double cutoff, double skin);
+
+  // Getters
+  double getCutoff() const { return _cutoff; }
+  double getSkin() const { return _skin; }
+  double getRadius() const { return _cutoff + _skin; }
+  size_t getNbBuilds() const { return _nbBuilds; }
+  const NeighbourRows& getRows() const { return _rows; }
+  const NeighbourRows& getGhostRows() const { return _ghostRows; }
+
+  /**
+   * @brief Tells if the list has to be rebuilt: a particle moved
+   *        by more than half of the skin since the last build,
+   *        or particles were removed.
+   * @param particles
+   * @return bool
+   */
+  bool needsRebuild(const ParticleStore& particles) const;
+
+  /**
+   * @brief Builds the list from cells of side at least getRadius(),
+   *        filled (with their ghosts for a PERIODIC universe).
+   * @param particles
+   * @param cells
+   */
+  void build(const ParticleStore& particles, const CellList& cells);
+};
+
+#endif  // _VERLET_LIST_HPP_
@@ -42,6 +42,8 @@ class VisualGenerator {
   // Verlet function)
   static inline std::string _videoScriptName = "video.gnu";
   static inline std::string _videoFolderName = "video";
+  // Frames of the video decoded from a compressed trajectory
+  static inline std::string _videoFramesFileName = "videoFrames.trj";
 
   /**
    * @brief Says if wa can use a color palette to represent the universe
@@ -81,10 +83,13 @@ class VisualGenerator {
   void setAxesRanges(std::ofstream& scriptFile) const;
 
   /**
-   * @brief Writes the plot command in the video script
+   * @brief Writes the plot command in the video script,
+   *        plotting the frame frames[n] of the trajectory file
    * @param scriptFile
+   * @param dataFileName trajectory file plotted
    */
-  void writeVideoPlotCommand(std::ofstream& scriptFile) const;
+  void writeVideoPlotCommand(std::ofstream& scriptFile,
+                             const std::string& dataFileName) const;
 
   /**
    * @brief Writes the plot command in the photo script
@@ -132,8 +137,9 @@ class VisualGenerator {
   /**
    * @brief Generates a video (multiple images) of the past states
    *        the universe has been into.
-   * @param numberFrames number of images to generate
-   *                     (must be smaller than past states)
+   * @param numberFrames number of images to generate, throws
+   *                     std::invalid_argument if it is greater than
+   *                     the number of frames written
    */
   void generateVideo(size_t numberFrames) const;
 };
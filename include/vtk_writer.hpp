@@ -0,0 +1,101 @@
+/**
+ * @file vtk_writer.hpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief VTK files (.vtu) of the past states of a universe,
+ *        gathered in a time series (.pvd)
+ * @version 0.1
+ * @date 2026-10-16
+ */
+
+#ifndef _VTK_WRITER_HPP_
+#define _VTK_WRITER_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "particle_store.hpp"
+
+/* Encoding of the appended data of the VTK files:
+   raw bytes (smallest and fastest), or base64 text */
+enum VtkEncoding { RAW, BASE64 };
+
+/**
+ * @brief Writes a VTK unstructured grid file (.vtu) per frame in a
+ *        folder, and the collection file particles.pvd which gives
+ *        the time of each frame to ParaView.
+ *
+ *        Arrays are Float32, in the appended section of the file
+ *        (format="appended"), each one preceded by its size in bytes
+ *        (UInt64 header). Points hold the positions (3 components,
+ *        0 on missing dimensions), point data the velocities and
+ *        the masses.
+ *
+ *        VTU files cannot share arrays, so the block of the masses
+ *        is only encoded again when the particles change (new ids),
+ *        and copied as is otherwise.
+ */
+class VtkWriter {
+ private:
+  std::string _folderName;
+  size_t _dimension;
+  VtkEncoding _encoding;
+  bool _closed = false;
+
+  /* Name and time of the files written, for the collection */
+  std::vector<std::string> _fileNames;
+  std::vector<double> _times;
+
+  /* Appended section of the frame being written */
+  std::string _appended;
+  std::vector<float> _values;
+
+  /* Encoded masses, and ids of the particles they belong to */
+  std::string _massesBlock;
+  std::vector<int> _massesIds;
+
+  /**
+   * @brief Appends a block of _values to data: its size
+   *        then its bytes, encoded
+   * @param data
+   */
+  void appendBlock(std::string& data) const;
+
+  /**
+   * @brief Appends a block of vectors with 3 components
+   * @param vectors
+   */
+  void appendVectors(const std::vector<Vector>& vectors);
+
+ public:
+  /**
+   * @brief Create the folder folderName (replaced if it exists)
+   * @param folderName
+   * @param dimension 1, 2 or 3
+   * @param encoding RAW by default
+   */
+  VtkWriter(const std::string& folderName, size_t dimension,
+            VtkEncoding encoding = RAW);
+
+  ~VtkWriter();
+
+  VtkWriter(const VtkWriter&) = delete;
+  VtkWriter& operator=(const VtkWriter&) = delete;
+
+  size_t getNbFrames() const { return _fileNames.size(); }
+
+  /**
+   * @brief Writes the file of a frame
+   * @param particles
+   * @param time
+   */
+  void writeFrame(const ParticleStore& particles, double time);
+
+  /**
+   * @brief Writes the collection of the frames (particles.pvd)
+   *        (done by the destructor otherwise)
+   */
+  void close();
+};
+
+#endif  // _VTK_WRITER_HPP_
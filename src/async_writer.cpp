@@ -0,0 +1,103 @@
+#include "async_writer.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+/* ------------------------------- private ------------------------------ */
+
+void AsyncWriter::writerLoop() {
+  bool failed = false;
+  while (true) {
+    size_t snapshot;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _snapshotReady.wait(lock, [&] { return !_ready.empty() || _stopping; });
+      if (_ready.empty()) return;
+      snapshot = _ready.front();
+      _ready.pop_front();
+    }
+
+    // Frames after an error are dropped
+    if (!failed) {
+      try {
+        _write(_snapshots[snapshot].particles, _snapshots[snapshot].time);
+      } catch (...) {
+        failed = true;
+        std::lock_guard<std::mutex> lock(_mutex);
+        _error = std::current_exception();
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _free.push_back(snapshot);
+    }
+    _snapshotFree.notify_one();
+  }
+}
+
+void AsyncWriter::rethrowError() {
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::swap(error, _error);
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+/* ------------------------------- public ------------------------------- */
+
+AsyncWriter::AsyncWriter(size_t dimension, FrameWriter write,
+                         size_t nbSnapshots)
+    : _write(std::move(write)) {
+  if (nbSnapshots == 0) {
+    throw std::invalid_argument("An AsyncWriter needs a snapshot.");
+  }
+  _snapshots.assign(nbSnapshots, Snapshot{ParticleStore(dimension), 0});
+  for (size_t i = 0; i < nbSnapshots; i++) _free.push_back(i);
+  _thread = std::thread(&AsyncWriter::writerLoop, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+  try {
+    finish();
+  } catch (...) {
+    // Errors are only reported by push and finish
+  }
+}
+
+void AsyncWriter::push(const ParticleStore& particles, double time) {
+  size_t snapshot;
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _snapshotFree.wait(lock, [&] { return !_free.empty() || _error; });
+  }
+  rethrowError();
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    snapshot = _free.back();
+    _free.pop_back();
+  }
+
+  // The snapshot belongs to this thread until it is ready
+  _snapshots[snapshot].particles.copyOutputColumns(particles);
+  _snapshots[snapshot].time = time;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _ready.push_back(snapshot);
+  }
+  _snapshotReady.notify_one();
+}
+
+void AsyncWriter::finish() {
+  if (_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopping = true;
+    }
+    _snapshotReady.notify_one();
+    _thread.join();
+  }
+  rethrowError();
+}
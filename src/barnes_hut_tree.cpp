@@ -0,0 +1,365 @@
+#include "barnes_hut_tree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <dimension_kernels.hpp>
+#include <numeric>
+#include <stdexcept>
+#include <xassert.hpp>
+
+/* ------------------------------- intern ------------------------------- */
+
+/* Index in Node::quadrupole of the component (a, b) */
+static constexpr size_t quadrupoleIndex[3][3] = {
+    {0, 3, 4}, {3, 1, 5}, {4, 5, 2}};
+
+/* Below this depth, a node cannot be cut anymore
+   (particles at the same position) */
+static constexpr size_t maxDepth = 48;
+
+/**
+ * @brief Adds to quadrupole the moment of a mass at offset d
+ *        from the centre of mass, m (3 d dᵀ - |d|² I)
+ * @param quadrupole
+ * @param mass
+ * @param d
+ */
+static void addPointQuadrupole(double* quadrupole, double mass,
+                               const double* d) {
+  double squaredNorm = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+  for (size_t a = 0; a < 3; a++) {
+    quadrupole[a] += mass * (3 * d[a] * d[a] - squaredNorm);
+  }
+  quadrupole[3] += 3 * mass * d[0] * d[1];
+  quadrupole[4] += 3 * mass * d[0] * d[2];
+  quadrupole[5] += 3 * mass * d[1] * d[2];
+}
+
+/* ------------------------------- private ------------------------------- */
+
+void BarnesHutTree::computeLeafMoments(const ParticleStore& particles,
+                                       Node& node) const {
+  const std::vector<Vector>& positions = particles.getPositions();
+  const std::vector<double>& masses = particles.getMasses();
+
+  node.mass = 0;
+  std::fill(node.massCenter, node.massCenter + 3, 0.0);
+  std::fill(node.quadrupole, node.quadrupole + 6, 0.0);
+  for (size_t k = node.begin; k < node.end; k++) {
+    size_t i = _indices[k];
+    node.mass += masses[i];
+    for (size_t d = 0; d < _dimension; d++) {
+      node.massCenter[d] += masses[i] * positions[i][d];
+    }
+  }
+  if (node.mass == 0) {
+    std::copy(node.center, node.center + 3, node.massCenter);
+    return;
+  }
+  for (size_t d = 0; d < _dimension; d++) node.massCenter[d] /= node.mass;
+
+  if (!_quadrupole) return;
+  for (size_t k = node.begin; k < node.end; k++) {
+    size_t i = _indices[k];
+    double offset[3] = {0, 0, 0};
+    for (size_t d = 0; d < _dimension; d++) {
+      offset[d] = positions[i][d] - node.massCenter[d];
+    }
+    addPointQuadrupole(node.quadrupole, masses[i], offset);
+  }
+}
+
+void BarnesHutTree::computeNodeMoments(std::vector<Node>& nodes,
+                                       size_t index) const {
+  size_t nbChildren = size_t(1) << _dimension;
+  size_t firstChild = nodes[index].firstChild;
+
+  double mass = 0;
+  double massCenter[3] = {0, 0, 0};
+  for (size_t c = firstChild; c < firstChild + nbChildren; c++) {
+    mass += nodes[c].mass;
+    for (size_t d = 0; d < 3; d++) {
+      massCenter[d] += nodes[c].mass * nodes[c].massCenter[d];
+    }
+  }
+
+  Node& node = nodes[index];
+  node.mass = mass;
+  std::fill(node.quadrupole, node.quadrupole + 6, 0.0);
+  if (mass == 0) {
+    std::copy(node.center, node.center + 3, node.massCenter);
+    return;
+  }
+  for (size_t d = 0; d < 3; d++) node.massCenter[d] = massCenter[d] / mass;
+
+  // Parallel axis theorem: moments of the children moved
+  // to the centre of mass of the node
+  if (!_quadrupole) return;
+  for (size_t c = firstChild; c < firstChild + nbChildren; c++) {
+    const Node& child = nodes[c];
+    if (child.mass == 0) continue;
+    double offset[3];
+    for (size_t d = 0; d < 3; d++) {
+      offset[d] = child.massCenter[d] - node.massCenter[d];
+    }
+    for (size_t q = 0; q < 6; q++) node.quadrupole[q] += child.quadrupole[q];
+    addPointQuadrupole(node.quadrupole, child.mass, offset);
+  }
+}
+
+void BarnesHutTree::buildNode(const ParticleStore& particles,
+                              std::vector<Node>& nodes, size_t index,
+                              size_t begin, size_t end, size_t depth,
+                              size_t spawnDepth,
+                              std::vector<Subtree>* subtrees) {
+  nodes[index].begin = begin;
+  nodes[index].end = end;
+  nodes[index].firstChild = NO_CHILD;
+  if (end - begin <= _leafSize || depth == maxDepth) {
+    computeLeafMoments(particles, nodes[index]);
+    return;
+  }
+  if (subtrees && depth == spawnDepth) {
+    subtrees->push_back(Subtree{index, begin, end, depth});
+    return;
+  }
+
+  // Partition the indices by child: child c is on the upper side
+  // of the centre in dimension d if bit d of c is set
+  const std::vector<Vector>& positions = particles.getPositions();
+  const Node parent = nodes[index];
+  size_t nbChildren = size_t(1) << _dimension;
+  size_t bounds[9];
+  bounds[0] = begin;
+  bounds[nbChildren] = end;
+  for (size_t d = _dimension; d-- > 0;) {
+    size_t half = size_t(1) << d;
+    for (size_t c = 0; c < nbChildren; c += 2 * half) {
+      size_t* middle = std::partition(
+          _indices.data() + bounds[c], _indices.data() + bounds[c + 2 * half],
+          [&](size_t i) { return positions[i][d] < parent.center[d]; });
+      bounds[c + half] = middle - _indices.data();
+    }
+  }
+
+  // Children are added before recursing, so that they are contiguous
+  size_t firstChild = nodes.size();
+  nodes[index].firstChild = firstChild;
+  double halfSide = parent.halfSide / 2;
+  for (size_t c = 0; c < nbChildren; c++) {
+    Node child = Node();
+    child.halfSide = halfSide;
+    for (size_t d = 0; d < 3; d++) {
+      double side = (c >> d) & 1 ? halfSide : -halfSide;
+      child.center[d] = d < _dimension ? parent.center[d] + side : 0;
+    }
+    nodes.push_back(child);
+  }
+  for (size_t c = 0; c < nbChildren; c++) {
+    buildNode(particles, nodes, firstChild + c, bounds[c], bounds[c + 1],
+              depth + 1, spawnDepth, subtrees);
+  }
+  computeNodeMoments(nodes, index);
+}
+
+template <size_t D>
+void BarnesHutTree::applyGravitationKernel(ParticleStore& particles,
+                                           size_t first, size_t last) const {
+  const std::vector<Vector>& positions = particles.getPositions();
+  const std::vector<double>& masses = particles.getMasses();
+  std::vector<Vector>& forces = particles.getForces();
+  constexpr size_t nbChildren = size_t(1) << D;
+  double squaredAngle = _openingAngle * _openingAngle;
+  double squaredSoftening = _softening * _softening;
+
+  std::vector<size_t> stack;
+  for (size_t t = first; t < last; t++) {
+    double position[D];
+    double acceleration[D] = {};
+    for (size_t d = 0; d < D; d++) position[d] = positions[t][d];
+
+    stack.assign(1, 0);
+    while (!stack.empty()) {
+      const Node& node = _nodes[stack.back()];
+      stack.pop_back();
+      if (node.mass == 0) continue;
+
+      // Leaves are summed particle by particle
+      if (node.isLeaf()) {
+        for (size_t k = node.begin; k < node.end; k++) {
+          size_t s = _indices[k];
+          if (s == t) continue;
+          double offset[D];
+          double squaredDistance = squaredSoftening;
+          for (size_t d = 0; d < D; d++) {
+            offset[d] = positions[s][d] - position[d];
+            squaredDistance += offset[d] * offset[d];
+          }
+          double inv2 = 1 / squaredDistance;
+          double factor = masses[s] * inv2 * std::sqrt(inv2);
+          for (size_t d = 0; d < D; d++) acceleration[d] += factor * offset[d];
+        }
+        continue;
+      }
+
+      // Open the nodes seen under a too large angle,
+      // and those containing the particle
+      double x[D];
+      double squaredDistance = 0;
+      bool inside = true;
+      for (size_t d = 0; d < D; d++) {
+        x[d] = position[d] - node.massCenter[d];
+        squaredDistance += x[d] * x[d];
+        inside = inside &&
+                 std::abs(position[d] - node.center[d]) <= node.halfSide;
+      }
+      double side = 2 * node.halfSide;
+      if (inside || side * side >= squaredAngle * squaredDistance) {
+        for (size_t c = 0; c < nbChildren; c++) {
+          stack.push_back(node.firstChild + c);
+        }
+        continue;
+      }
+
+      // a = -M x / r³ + Q x / r⁵ - 5/2 (xᵀ Q x) x / r⁷
+      double inv2 = 1 / (squaredDistance + squaredSoftening);
+      double inv3 = inv2 * std::sqrt(inv2);
+      for (size_t d = 0; d < D; d++) {
+        acceleration[d] -= node.mass * inv3 * x[d];
+      }
+      if (!_quadrupole) continue;
+      double qx[D];
+      double xqx = 0;
+      for (size_t a = 0; a < D; a++) {
+        qx[a] = 0;
+        for (size_t b = 0; b < D; b++) {
+          qx[a] += node.quadrupole[quadrupoleIndex[a][b]] * x[b];
+        }
+        xqx += x[a] * qx[a];
+      }
+      double inv5 = inv3 * inv2;
+      double inv7 = inv5 * inv2;
+      for (size_t d = 0; d < D; d++) {
+        acceleration[d] += qx[d] * inv5 - 2.5 * xqx * x[d] * inv7;
+      }
+    }
+
+    for (size_t d = 0; d < D; d++) {
+      forces[t][d] += masses[t] * acceleration[d];
+    }
+  }
+}
+
+/* ------------------------------- public ------------------------------- */
+
+BarnesHutTree::BarnesHutTree(size_t dimension) : _dimension(dimension) {
+  xassert(dimension > 0 && dimension <= 3, "Dimension must be 1, 2 or 3.");
+}
+
+void BarnesHutTree::setOpeningAngle(double openingAngle) {
+  if (openingAngle < 0) {
+    throw std::invalid_argument("Opening angle must be positive.");
+  }
+  _openingAngle = openingAngle;
+}
+
+void BarnesHutTree::setSoftening(double softening) {
+  if (softening < 0) {
+    throw std::invalid_argument("Softening length must be positive.");
+  }
+  _softening = softening;
+}
+
+void BarnesHutTree::setLeafSize(size_t leafSize) {
+  if (leafSize == 0) {
+    throw std::invalid_argument("Leaves must hold at least one particle.");
+  }
+  _leafSize = leafSize;
+}
+
+void BarnesHutTree::build(const ParticleStore& particles, ThreadPool* pool) {
+  xassert(particles.getDimension() == _dimension,
+          "Particles must have the dimension of the tree.");
+  const std::vector<Vector>& positions = particles.getPositions();
+  size_t nbParticles = particles.size();
+  _indices.resize(nbParticles);
+  std::iota(_indices.begin(), _indices.end(), 0);
+
+  // Root: cube around all the particles
+  Node root = Node();
+  double halfSide = 0;
+  for (size_t d = 0; d < _dimension; d++) {
+    double lower = 0, upper = 0;
+    if (nbParticles > 0) {
+      auto [minimum, maximum] = std::minmax_element(
+          positions.begin(), positions.end(),
+          [&](const Vector& a, const Vector& b) { return a[d] < b[d]; });
+      lower = (*minimum)[d];
+      upper = (*maximum)[d];
+    }
+    root.center[d] = (lower + upper) / 2;
+    halfSide = std::max(halfSide, (upper - lower) / 2);
+  }
+  root.halfSide = halfSide > 0 ? halfSide : 1;
+  _nodes.assign(1, root);
+
+  if (!pool || pool->getNbThreads() == 1) {
+    buildNode(particles, _nodes, 0, 0, nbParticles, 0, 0, nullptr);
+    return;
+  }
+
+  // First levels, until there are a few subtrees for each thread
+  size_t spawnDepth = 0;
+  for (size_t nbSubtrees = 1; nbSubtrees < 4 * pool->getNbThreads();
+       nbSubtrees <<= _dimension) {
+    spawnDepth++;
+  }
+  _subtrees.clear();
+  buildNode(particles, _nodes, 0, 0, nbParticles, 0, spawnDepth, &_subtrees);
+  size_t nbTopNodes = _nodes.size();
+
+  // Subtrees, each one in its own array
+  _subtreeNodes.resize(_subtrees.size());
+  pool->parallelForWeighted(
+      _subtrees.size(),
+      [&](size_t s) { return _subtrees[s].end - _subtrees[s].begin + 1.0; },
+      [&](size_t first, size_t last, size_t) {
+        for (size_t s = first; s < last; s++) {
+          const Subtree& subtree = _subtrees[s];
+          std::vector<Node>& nodes = _subtreeNodes[s];
+          nodes.assign(1, _nodes[subtree.node]);
+          buildNode(particles, nodes, 0, subtree.begin, subtree.end,
+                    subtree.depth, 0, nullptr);
+        }
+      });
+
+  // Subtrees are appended, their root replacing the node they grew
+  // from: node k > 0 of a subtree moves to offset + k - 1
+  for (size_t s = 0; s < _subtrees.size(); s++) {
+    const std::vector<Node>& nodes = _subtreeNodes[s];
+    size_t offset = _nodes.size();
+    auto moved = [&](Node node) {
+      if (!node.isLeaf()) node.firstChild += offset - 1;
+      return node;
+    };
+    _nodes[_subtrees[s].node] = moved(nodes[0]);
+    for (size_t k = 1; k < nodes.size(); k++) {
+      _nodes.push_back(moved(nodes[k]));
+    }
+  }
+
+  // Moments of the first levels, children having greater indices
+  for (size_t index = nbTopNodes; index-- > 0;) {
+    if (!_nodes[index].isLeaf()) computeNodeMoments(_nodes, index);
+  }
+}
+
+void BarnesHutTree::applyGravitation(ParticleStore& particles, size_t first,
+                                     size_t last) const {
+  xassert(_indices.size() == particles.size(),
+          "Tree must be built with the particles given.");
+  if (first >= last) return;
+  dispatchDimension(_dimension, [&](auto dimension) {
+    applyGravitationKernel<decltype(dimension)::value>(particles, first, last);
+  });
+}
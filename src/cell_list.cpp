@@ -0,0 +1,298 @@
+#include "cell_list.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <xassert.hpp>
+
+/* ------------------------------- intern ------------------------------- */
+
+/**
+ * @brief Goes to the next coordinates of a grid, first
+ *        dimension varying fastest (like the cell indices).
+ * @param coordinates current coordinates, updated
+ * @param min minimum value of every coordinate
+ * @param max maximum value of each coordinate (included)
+ * @return false when all coordinates have been visited
+ */
+static bool nextCoordinates(std::vector<int>& coordinates, int min,
+                            const std::vector<int>& max) {
+  for (size_t i = 0; i < coordinates.size(); i++) {
+    if (coordinates[i] < max[i]) {
+      coordinates[i]++;
+      return true;
+    }
+    coordinates[i] = min;
+  }
+  return false;
+}
+
+/* ------------------------------- private ------------------------------- */
+
+size_t CellList::internCellIndex(const std::vector<int>& coordinates) const {
+  xassert(coordinates.size() == _dimensions.size(),
+          "Coordinates and grid dimensions must match.");
+
+  size_t index = 0;
+  size_t multiplier = 1;
+  for (size_t i = 0; i < _dimensions.size(); i++) {
+    index += coordinates[i] * multiplier;
+    multiplier *= _dimensions[i];
+  }
+  return index;
+}
+
+/* Offsets are visited with the first dimension varying fastest,
+   so neighbours are added by increasing index. */
+void CellList::addNeighbourCells(const std::vector<int>& coordinates,
+                                 std::vector<size_t>& neighbours) const {
+  size_t dim = _dimensions.size();
+  std::vector<int> offset(dim, -1);
+  std::vector<int> maxOffset(dim, 1);
+  std::vector<int> neighbourCoordinates(dim);
+  do {
+    bool isCenter = true;
+    bool isIntern = true;
+    for (size_t i = 0; i < dim; i++) {
+      neighbourCoordinates[i] = coordinates[i] + offset[i];
+      isCenter = isCenter && offset[i] == 0;
+      isIntern = isIntern && neighbourCoordinates[i] >= 0 &&
+                 neighbourCoordinates[i] < _dimensions[i];
+    }
+    if (isIntern && !isCenter) {
+      neighbours.push_back(internCellIndex(neighbourCoordinates));
+    }
+  } while (nextCoordinates(offset, -1, maxOffset));
+}
+
+void CellList::createInternCells() {
+  size_t nbCells = 1;
+  for (int nb : _dimensions) nbCells *= nb;
+
+  std::vector<int> coordinates(_dimensions.size(), 0);
+  std::vector<int> maxCoordinates(_dimensions.size());
+  for (size_t i = 0; i < _dimensions.size(); i++) {
+    maxCoordinates[i] = _dimensions[i] - 1;
+  }
+
+  _neighbourStart.reserve(nbCells + 1);
+  _neighbourStart.push_back(0);
+  do {
+    addNeighbourCells(coordinates, _neighbours);
+    _neighbourStart.push_back(_neighbours.size());
+  } while (nextCoordinates(coordinates, 0, maxCoordinates));
+
+  xassert(_neighbourStart.size() == nbCells + 1,
+          "Every intern cell must have been visited.");
+  _cellStart.assign(nbCells + 1, 0);
+}
+
+/* Border cells have at least one coordinate equal to -1 or _dimensions[i].
+   They copy the intern cell on the other side of the universe. */
+void CellList::createBorderCells() {
+  size_t dim = _dimensions.size();
+  Vector universeSizes = _upperBound - _lowerBound;
+
+  std::vector<int> coordinates(dim, -1);
+  std::vector<int> copyCellCoordinates(dim);
+  _borderNeighbourStart.push_back(0);
+  do {
+    bool isBorder = false;
+    Vector offset(dim);
+    for (size_t i = 0; i < dim; i++) {
+      if (coordinates[i] == -1) {
+        isBorder = true;
+        offset[i] -= universeSizes[i];
+        copyCellCoordinates[i] = _dimensions[i] - 1;
+      } else if (coordinates[i] == _dimensions[i]) {
+        isBorder = true;
+        offset[i] += universeSizes[i];
+        copyCellCoordinates[i] = 0;
+      } else {
+        copyCellCoordinates[i] = coordinates[i];
+      }
+    }
+    if (!isBorder) continue;
+
+    xassert(offset != Vector(dim), std::stringstream()
+                                       << "offset shouldn't be zero. offset = "
+                                       << offset);
+    _borderCopyCell.push_back(internCellIndex(copyCellCoordinates));
+    _borderOffset.push_back(offset);
+    addNeighbourCells(coordinates, _borderNeighbours);
+    _borderNeighbourStart.push_back(_borderNeighbours.size());
+  } while (nextCoordinates(coordinates, -1, _dimensions));
+
+  _ghostStart.assign(_borderCopyCell.size() + 1, 0);
+}
+
+void CellList::createCells() {
+  _dimensions.clear();
+  _neighbourStart.clear();
+  _neighbours.clear();
+  _borderCopyCell.clear();
+  _borderOffset.clear();
+  _borderNeighbourStart.clear();
+  _borderNeighbours.clear();
+  _particleCell.clear();
+  _cellParticles.clear();
+  clearGhosts();
+
+  // Computes how many cells fit in each dimension
+  Vector universeSizes = _upperBound - _lowerBound;
+  _cellSides = Vector(universeSizes.getDimension());
+  for (size_t i = 0; i < universeSizes.getDimension(); i++) {
+    int nbCells = static_cast<int>(std::floor(universeSizes[i] / _cellSide));
+    nbCells = std::max(nbCells, 1);
+    _dimensions.push_back(nbCells);
+    _cellSides[i] = universeSizes[i] / nbCells;
+  }
+
+  createInternCells();
+  createBorderCells();
+}
+
+void CellList::runOnThreads(ThreadPool* pool,
+                            const std::function<void(size_t)>& job) {
+  if (pool) {
+    pool->run(job);
+  } else {
+    job(0);
+  }
+}
+
+/* ------------------------------- public ------------------------------- */
+
+CellList::CellList(const Vector& lowerBound, const Vector& upperBound,
+                   double cellSide, const DimensionKernels& kernels)
+    : _kernels(kernels),
+      _lowerBound(lowerBound),
+      _upperBound(upperBound),
+      _cellSide(cellSide),
+      _ghosts(lowerBound.getDimension()) {
+  xassert(cellSide > 0, "Cell side must be positive.");
+  xassert(kernels.dimension == lowerBound.getDimension(),
+          "Kernels and bounds dimensions must match.");
+
+  createCells();
+}
+
+void CellList::setCellSide(double cellSide) {
+  xassert(cellSide > 0, "Cell side must be positive.");
+  _cellSide = cellSide;
+  createCells();
+}
+
+void CellList::fill(const ParticleStore& particles, ThreadPool* pool) {
+  const std::vector<Vector>& positions = particles.getPositions();
+  size_t nbParticles = particles.size();
+  size_t nbCells = getNbCells();
+  size_t nbThreads = pool ? pool->getNbThreads() : 1;
+  _particleCell.resize(nbParticles);
+  _threadCellCursors.resize(nbThreads);
+
+  // Each thread counts the particles of its block in each cell
+  runOnThreads(pool, [&](size_t thread) {
+    std::vector<size_t>& counts = _threadCellCursors[thread];
+    counts.assign(nbCells, 0);
+    size_t first = thread * nbParticles / nbThreads;
+    size_t last = (thread + 1) * nbParticles / nbThreads;
+    for (size_t i = first; i < last; i++) {
+      xassert(positions[i].isInBounds(_lowerBound, _upperBound),
+              "Position has to be inside the bounds of the gridded universe.");
+      size_t cell = _kernels.cellIndex(positions[i], _lowerBound, _cellSides,
+                                       _dimensions);
+      _particleCell[i] = cell;
+      counts[cell]++;
+    }
+  });
+
+  // Prefix sum gives the start of each cell, and the cursor
+  // of each thread in each cell (blocks in thread order)
+  _cellStart[0] = 0;
+  for (size_t c = 0; c < nbCells; c++) {
+    size_t cursor = _cellStart[c];
+    for (std::vector<size_t>& cursors : _threadCellCursors) {
+      size_t count = cursors[c];
+      cursors[c] = cursor;
+      cursor += count;
+    }
+    _cellStart[c + 1] = cursor;
+  }
+
+  // Each thread scatters the indices of its block
+  // (stable, cells keep increasing indices)
+  _cellParticles.resize(nbParticles);
+  runOnThreads(pool, [&](size_t thread) {
+    std::vector<size_t>& cursors = _threadCellCursors[thread];
+    size_t first = thread * nbParticles / nbThreads;
+    size_t last = (thread + 1) * nbParticles / nbThreads;
+    for (size_t i = first; i < last; i++) {
+      _cellParticles[cursors[_particleCell[i]]++] = i;
+    }
+  });
+}
+
+void CellList::fillGhosts(const ParticleStore& particles, ThreadPool* pool) {
+  // Ghosts of each border cell are the particles of its copied cell
+  size_t nbBorderCells = getNbBorderCells();
+  _ghostStart[0] = 0;
+  for (size_t b = 0; b < nbBorderCells; b++) {
+    _ghostStart[b + 1] =
+        _ghostStart[b] + getCellParticles(_borderCopyCell[b]).size();
+  }
+  _ghosts.resize(_ghostStart[nbBorderCells]);
+  _ghostSource.resize(_ghostStart[nbBorderCells]);
+
+  // Border cells are copied in parallel, each in its own range
+  std::vector<Vector>& ghostPositions = _ghosts.getPositions();
+  auto copyBorderCells = [&](size_t first, size_t last, size_t) {
+    for (size_t b = first; b < last; b++) {
+      size_t ghost = _ghostStart[b];
+      for (size_t i : getCellParticles(_borderCopyCell[b])) {
+        _ghosts.setCopy(particles, i, ghost);
+        ghostPositions[ghost] += _borderOffset[b];
+        _ghostSource[ghost] = i;
+        ghost++;
+      }
+    }
+  };
+  if (pool) {
+    pool->parallelForWeighted(
+        nbBorderCells,
+        [&](size_t b) { return _ghostStart[b + 1] - _ghostStart[b] + 1.0; },
+        copyBorderCells);
+  } else {
+    copyBorderCells(0, nbBorderCells, 0);
+  }
+}
+
+void CellList::refreshGhosts(const ParticleStore& particles,
+                             ThreadPool* pool) {
+  std::vector<Vector>& ghostPositions = _ghosts.getPositions();
+  std::vector<Vector>& ghostSpeeds = _ghosts.getSpeeds();
+  const std::vector<Vector>& positions = particles.getPositions();
+  const std::vector<Vector>& speeds = particles.getSpeeds();
+  auto refreshBorderCells = [&](size_t first, size_t last, size_t) {
+    for (size_t b = first; b < last; b++) {
+      for (size_t g = _ghostStart[b]; g < _ghostStart[b + 1]; g++) {
+        ghostPositions[g] = positions[_ghostSource[g]] + _borderOffset[b];
+        ghostSpeeds[g] = speeds[_ghostSource[g]];
+      }
+    }
+  };
+  if (pool) {
+    pool->parallelForWeighted(
+        getNbBorderCells(),
+        [&](size_t b) { return _ghostStart[b + 1] - _ghostStart[b] + 1.0; },
+        refreshBorderCells);
+  } else {
+    refreshBorderCells(0, getNbBorderCells(), 0);
+  }
+}
+
+void CellList::clearGhosts() {
+  _ghosts.clear();
+  _ghostSource.clear();
+  std::fill(_ghostStart.begin(), _ghostStart.end(), 0);
+}
@@ -0,0 +1,207 @@
+#include <cmath>
+#include <dimension_kernels.hpp>
+#include <xassert.hpp>
+
+/* ------------------------------- intern ------------------------------- */
+
+/* Every kernel is a template on the dimension D.
+   Loops on coordinates have a constant bound,
+   so they are fully unrolled by the compiler. */
+
+template <size_t D>
+void kickDriftAndResetForcesKernel(ParticleStore& particles, double timeStep,
+                                   const Vector& field, size_t first,
+                                   size_t last, Vector& minPosition,
+                                   Vector& maxPosition,
+                                   double& maxSquaredForce) {
+  std::vector<Vector>& positions = particles.getPositions();
+  std::vector<Vector>& speeds = particles.getSpeeds();
+  std::vector<Vector>& forces = particles.getForces();
+  const std::vector<double>& masses = particles.getMasses();
+  for (size_t i = first; i < last; i++) {
+    double squaredForce = 0;
+    double halfStepOverMass = 0.5 * timeStep / masses[i];
+    for (size_t k = 0; k < D; k++) {
+      if (positions[i][k] < minPosition[k]) minPosition[k] = positions[i][k];
+      if (positions[i][k] > maxPosition[k]) maxPosition[k] = positions[i][k];
+      squaredForce += forces[i][k] * forces[i][k];
+
+      speeds[i][k] += forces[i][k] * halfStepOverMass;
+      positions[i][k] += speeds[i][k] * timeStep;
+      forces[i][k] = masses[i] * field[k];
+    }
+    if (squaredForce > maxSquaredForce) maxSquaredForce = squaredForce;
+  }
+}
+
+template <size_t D>
+double halfKickAndEnergyKernel(ParticleStore& particles, double timeStep,
+                               size_t first, size_t last) {
+  std::vector<Vector>& speeds = particles.getSpeeds();
+  const std::vector<Vector>& forces = particles.getForces();
+  const std::vector<double>& masses = particles.getMasses();
+  double sum = 0;
+  for (size_t i = first; i < last; i++) {
+    double halfStepOverMass = 0.5 * timeStep / masses[i];
+    double squaredSpeed = 0;
+    for (size_t k = 0; k < D; k++) {
+      speeds[i][k] += forces[i][k] * halfStepOverMass;
+      squaredSpeed += speeds[i][k] * speeds[i][k];
+    }
+    sum += masses[i] * squaredSpeed;
+  }
+  return sum / 2;
+}
+
+template <size_t D>
+void kickSpeedsKernel(ParticleStore& particles,
+                      const std::vector<Vector>& forces, double timeStep,
+                      size_t first, size_t last) {
+  std::vector<Vector>& speeds = particles.getSpeeds();
+  const std::vector<double>& masses = particles.getMasses();
+  for (size_t i = first; i < last; i++) {
+    double stepOverMass = timeStep / masses[i];
+    for (size_t k = 0; k < D; k++) {
+      speeds[i][k] += forces[i][k] * stepOverMass;
+    }
+  }
+}
+
+template <size_t D>
+void driftPositionsKernel(ParticleStore& particles, double timeStep,
+                          size_t first, size_t last) {
+  std::vector<Vector>& positions = particles.getPositions();
+  const std::vector<Vector>& speeds = particles.getSpeeds();
+  for (size_t i = first; i < last; i++) {
+    for (size_t k = 0; k < D; k++) {
+      positions[i][k] += speeds[i][k] * timeStep;
+    }
+  }
+}
+
+template <size_t D>
+void setForcesToZeroKernel(ParticleStore& particles) {
+  for (Vector& force : particles.getForces()) {
+    for (size_t k = 0; k < D; k++) force[k] = 0;
+  }
+}
+
+template <size_t D>
+double cineticEnergyKernel(const ParticleStore& particles) {
+  const std::vector<Vector>& speeds = particles.getSpeeds();
+  const std::vector<double>& masses = particles.getMasses();
+  double sum = 0;
+  for (size_t i = 0; i < particles.size(); i++) {
+    double squaredSpeed = 0;
+    for (size_t k = 0; k < D; k++) squaredSpeed += speeds[i][k] * speeds[i][k];
+    sum += masses[i] * squaredSpeed;
+  }
+  return sum / 2;
+}
+
+template <size_t D>
+void updateExtremumValuesKernel(const ParticleStore& particles,
+                                Vector& minPosition, Vector& maxPosition,
+                                double& maxForce) {
+  const std::vector<Vector>& positions = particles.getPositions();
+  const std::vector<Vector>& forces = particles.getForces();
+  double maxSquaredForce = maxForce * maxForce;
+  for (size_t i = 0; i < particles.size(); i++) {
+    double squaredForce = 0;
+    for (size_t k = 0; k < D; k++) {
+      if (positions[i][k] < minPosition[k]) minPosition[k] = positions[i][k];
+      if (positions[i][k] > maxPosition[k]) maxPosition[k] = positions[i][k];
+      squaredForce += forces[i][k] * forces[i][k];
+    }
+    if (squaredForce > maxSquaredForce) maxSquaredForce = squaredForce;
+  }
+  maxForce = std::sqrt(maxSquaredForce);
+}
+
+template <size_t D>
+void reflectOutOfBoundsKernel(ParticleStore& particles,
+                              const Vector& lowerBound,
+                              const Vector& upperBound) {
+  std::vector<Vector>& positions = particles.getPositions();
+  std::vector<Vector>& speeds = particles.getSpeeds();
+  for (size_t p = 0; p < particles.size(); p++) {
+    for (size_t i = 0; i < D; i++) {
+      double coordValue = positions[p][i];
+      while (coordValue < lowerBound[i] || coordValue > upperBound[i]) {
+        double boundValue =
+            (coordValue < lowerBound[i]) ? lowerBound[i] : upperBound[i];
+        speeds[p][i] *= -1;
+        coordValue = 2 * boundValue - coordValue;
+        positions[p][i] = coordValue;
+      }
+    }
+    xassert(positions[p].isInBounds(lowerBound, upperBound),
+            "particle should not be out of bounds anymore.");
+  }
+}
+
+template <size_t D>
+void teleportOutOfBoundsKernel(ParticleStore& particles,
+                               const Vector& lowerBound,
+                               const Vector& upperBound) {
+  std::vector<Vector>& positions = particles.getPositions();
+  for (size_t p = 0; p < particles.size(); p++) {
+    for (size_t i = 0; i < D; i++) {
+      double coordValue = positions[p][i];
+      if (coordValue < lowerBound[i] || coordValue > upperBound[i]) {
+        double divisor = upperBound[i] - lowerBound[i];
+        coordValue = std::fmod(
+            std::fmod(coordValue - lowerBound[i], divisor) + divisor, divisor);
+        positions[p][i] = coordValue;
+      }
+    }
+    xassert(positions[p].isInBounds(lowerBound, upperBound),
+            "particle should not be out of bounds anymore.");
+  }
+}
+
+/* For value in each dimension, we divide the distance to the lower
+   bound by the cellSide and we have the coordinate. On the upper
+   bound (or just below it, with rounding) this coordinate is one past
+   the last cell of the grid, so we decrease it by 1. */
+template <size_t D>
+size_t cellIndexKernel(const Vector& position, const Vector& lowerBound,
+                       const Vector& cellSides,
+                       const std::vector<int>& dimensions) {
+  size_t index = 0;
+  size_t multiplier = 1;
+  for (size_t i = 0; i < D; i++) {
+    int coord = static_cast<int>((position[i] - lowerBound[i]) / cellSides[i]);
+    if (coord == dimensions[i]) coord--;
+    xassert(coord >= 0 && coord < dimensions[i],
+            "Cell coordinate calculated is out of the grid.");
+    index += coord * multiplier;
+    multiplier *= dimensions[i];
+  }
+  return index;
+}
+
+template <size_t D>
+const DimensionKernels& kernelsTable() {
+  static const DimensionKernels table = {
+      D,
+      kickDriftAndResetForcesKernel<D>,
+      halfKickAndEnergyKernel<D>,
+      kickSpeedsKernel<D>,
+      driftPositionsKernel<D>,
+      setForcesToZeroKernel<D>,
+      cineticEnergyKernel<D>,
+      updateExtremumValuesKernel<D>,
+      reflectOutOfBoundsKernel<D>,
+      teleportOutOfBoundsKernel<D>,
+      cellIndexKernel<D>};
+  return table;
+}
+
+/* ------------------------------- public ------------------------------- */
+
+const DimensionKernels& getDimensionKernels(size_t dimension) {
+  return dispatchDimension(dimension, [](auto d) -> const DimensionKernels& {
+    return kernelsTable<decltype(d)::value>();
+  });
+}
@@ -0,0 +1,341 @@
+#include "distributed_universe.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <xassert.hpp>
+
+/* ------------------------------- private ------------------------------- */
+
+double DistributedUniverse::columnLowerBound(int column) const {
+  if (column == _nbColumns) return getUpperBound()[0];
+  return getLowerBound()[0] + column * _columnWidth;
+}
+
+/* The column computed by a division is corrected by one
+   if rounding put the position on the wrong side of a bound */
+int DistributedUniverse::columnOf(const Vector& position) const {
+  double x = position[0];
+  int column = static_cast<int>((x - getLowerBound()[0]) / _columnWidth);
+  column = std::clamp(column, 0, _nbColumns - 1);
+  if (column > 0 && x < columnLowerBound(column)) {
+    column--;
+  } else if (column + 1 < _nbColumns && x >= columnLowerBound(column + 1)) {
+    column++;
+  }
+  return column;
+}
+
+int DistributedUniverse::ownerOf(int column) const {
+  return std::upper_bound(_slabStarts.begin(), _slabStarts.end(), column) -
+         _slabStarts.begin() - 1;
+}
+
+void DistributedUniverse::createLocalCells() {
+  int first = std::max(_slabStarts[_rank] - 1, 0);
+  int last = std::min(_slabStarts[_rank + 1] + 1, _nbColumns);
+  Vector lowerBound = getLowerBound();
+  Vector upperBound = getUpperBound();
+  lowerBound[0] = columnLowerBound(first);
+  upperBound[0] = columnLowerBound(last);
+  _cells.emplace(lowerBound, upperBound, _cutoff, getKernels());
+}
+
+void DistributedUniverse::exchangePackets() {
+  std::vector<int> sendCounts(_nbRanks);
+  std::vector<int> sendDisplacements(_nbRanks);
+  std::vector<int> receiveCounts(_nbRanks);
+  std::vector<int> receiveDisplacements(_nbRanks);
+
+  _sendBuffer.clear();
+  for (int r = 0; r < _nbRanks; r++) {
+    sendDisplacements[r] = _sendBuffer.size();
+    sendCounts[r] = _sendPackets[r].size();
+    _sendBuffer.insert(_sendBuffer.end(), _sendPackets[r].begin(),
+                       _sendPackets[r].end());
+  }
+
+  MPI_Alltoall(sendCounts.data(), 1, MPI_INT, receiveCounts.data(), 1, MPI_INT,
+               _comm);
+  int receiveSize = 0;
+  for (int r = 0; r < _nbRanks; r++) {
+    receiveDisplacements[r] = receiveSize;
+    receiveSize += receiveCounts[r];
+  }
+  _receiveBuffer.resize(receiveSize);
+
+  MPI_Alltoallv(_sendBuffer.data(), sendCounts.data(),
+                sendDisplacements.data(), MPI_DOUBLE, _receiveBuffer.data(),
+                receiveCounts.data(), receiveDisplacements.data(), MPI_DOUBLE,
+                _comm);
+}
+
+/* A migrating particle is packed as its position, speed (kicked by
+   the first half of the step), force (uniform fields already applied
+   in a Störmer-Verlet step), mass and identifier. Names are cold
+   data, a migrated particle is named after its identifier. */
+void DistributedUniverse::migrateParticles() {
+  ParticleStore& particles = getParticles();
+  size_t dim = getDimension();
+  for (std::vector<double>& packet : _sendPackets) packet.clear();
+
+  const std::vector<Vector>& positions = particles.getPositions();
+  const std::vector<Vector>& speeds = particles.getSpeeds();
+  const std::vector<Vector>& forces = particles.getForces();
+  const std::vector<double>& masses = particles.getMasses();
+  const std::vector<int>& ids = particles.getIds();
+  particles.removeIf([&](size_t i) {
+    int owner = ownerOf(columnOf(positions[i]));
+    if (owner == _rank) return false;
+
+    std::vector<double>& packet = _sendPackets[owner];
+    packet.insert(packet.end(), positions[i].begin(), positions[i].end());
+    packet.insert(packet.end(), speeds[i].begin(), speeds[i].end());
+    packet.insert(packet.end(), forces[i].begin(), forces[i].end());
+    packet.push_back(masses[i]);
+    packet.push_back(ids[i]);
+    return true;
+  });
+
+  exchangePackets();
+
+  size_t packetSize = 3 * dim + 2;
+  for (size_t k = 0; k < _receiveBuffer.size(); k += packetSize) {
+    const double* data = _receiveBuffer.data() + k;
+    Vector position(dim);
+    Vector speed(dim);
+    Vector force(dim);
+    for (size_t i = 0; i < dim; i++) {
+      position[i] = data[i];
+      speed[i] = data[dim + i];
+      force[i] = data[2 * dim + i];
+    }
+    int id = static_cast<int>(data[3 * dim + 1]);
+    size_t p = particles.addWithId(position, speed, data[3 * dim],
+                                   "Particle " + std::to_string(id), id);
+    particles.getForces()[p] = force;
+  }
+}
+
+/* A halo particle is packed as its position, speed, mass
+   and identifier */
+void DistributedUniverse::exchangeHalo() {
+  ParticleStore& particles = getParticles();
+  size_t dim = getDimension();
+  for (std::vector<double>& packet : _sendPackets) packet.clear();
+
+  const std::vector<Vector>& positions = particles.getPositions();
+  const std::vector<Vector>& speeds = particles.getSpeeds();
+  const std::vector<double>& masses = particles.getMasses();
+  const std::vector<int>& ids = particles.getIds();
+  int firstColumn = _slabStarts[_rank];
+  int lastColumn = _slabStarts[_rank + 1] - 1;
+  for (size_t i = 0; i < _nbOwned; i++) {
+    int column = columnOf(positions[i]);
+    for (int neighbour : {_rank - 1, _rank + 1}) {
+      bool isNextToNeighbour = neighbour < _rank ? column == firstColumn
+                                                 : column == lastColumn;
+      if (neighbour < 0 || neighbour >= _nbRanks || !isNextToNeighbour) {
+        continue;
+      }
+      std::vector<double>& packet = _sendPackets[neighbour];
+      packet.insert(packet.end(), positions[i].begin(), positions[i].end());
+      packet.insert(packet.end(), speeds[i].begin(), speeds[i].end());
+      packet.push_back(masses[i]);
+      packet.push_back(ids[i]);
+    }
+  }
+
+  exchangePackets();
+
+  size_t packetSize = 2 * dim + 2;
+  for (size_t k = 0; k < _receiveBuffer.size(); k += packetSize) {
+    const double* data = _receiveBuffer.data() + k;
+    Vector position(dim);
+    Vector speed(dim);
+    for (size_t i = 0; i < dim; i++) {
+      position[i] = data[i];
+      speed[i] = data[dim + i];
+    }
+    particles.addWithId(position, speed, data[2 * dim], "",
+                        static_cast<int>(data[2 * dim + 1]));
+  }
+}
+
+/* Boundaries are put where the cumulated number of particles
+   reaches a multiple of the average per process */
+void DistributedUniverse::rebalance() {
+  const std::vector<Vector>& positions = getParticles().getPositions();
+  std::vector<long long> counts(_nbColumns, 0);
+  for (size_t i = 0; i < getParticles().size(); i++) {
+    counts[columnOf(positions[i])]++;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, counts.data(), _nbColumns, MPI_LONG_LONG,
+                MPI_SUM, _comm);
+
+  long long total = 0;
+  for (long long count : counts) total += count;
+
+  std::vector<int> slabStarts(_nbRanks + 1);
+  slabStarts[0] = 0;
+  slabStarts[_nbRanks] = _nbColumns;
+  int column = 0;
+  long long cumulated = 0;
+  for (int r = 1; r < _nbRanks; r++) {
+    long long target = total * r / _nbRanks;
+    while (column < _nbColumns && cumulated < target) {
+      cumulated += counts[column++];
+    }
+    slabStarts[r] =
+        std::clamp(column, slabStarts[r - 1] + 1, _nbColumns - (_nbRanks - r));
+  }
+
+  if (slabStarts != _slabStarts) {
+    _slabStarts = slabStarts;
+    createLocalCells();
+  }
+}
+
+void DistributedUniverse::applyHalfShellForces(size_t cell, PairBatch& batch,
+                                               std::vector<Vector>& forces) {
+  ParticleStore& particles = getParticles();
+  const std::vector<Interaction>& interactions = getActiveInteractions();
+  IndexSpan cellParticles = _cells->getCellParticles(cell);
+  for (const size_t* i = cellParticles.begin(); i != cellParticles.end();
+       i++) {
+    batch.clear();
+    if (*i < _nbOwned) {
+      // Next particles of the cell, and particles of forward neighbours
+      batch.addSources(IndexSpan(i + 1, cellParticles.end()));
+      for (size_t neighbour : _cells->getForwardNeighbours(cell)) {
+        batch.addSources(_cells->getCellParticles(neighbour));
+      }
+    } else {
+      // Halo particle: only owned particles of forward neighbours,
+      // which come first in the cells (next ones of the cell are halo)
+      for (size_t neighbour : _cells->getForwardNeighbours(cell)) {
+        IndexSpan sources = _cells->getCellParticles(neighbour);
+        batch.addSources(IndexSpan(
+            sources.begin(),
+            std::lower_bound(sources.begin(), sources.end(), _nbOwned)));
+      }
+    }
+    batch.applyForces(particles, *i, particles, interactions, true, forces);
+  }
+}
+
+/* ------------------------------- protected ------------------------------- */
+
+void DistributedUniverse::updateForces() {
+  if (_rebalancePeriod > 0 && _nbForceUpdates > 0 &&
+      _nbForceUpdates % _rebalancePeriod == 0) {
+    rebalance();
+  }
+  _nbForceUpdates++;
+
+  migrateParticles();
+  _nbOwned = getParticles().size();
+  exchangeHalo();
+  _cells->fill(getParticles(), getThreadPool());
+
+  FiniteUniverse::updateForces();
+
+  // Forces on the halo belong to the neighbour processes
+  getParticles().resize(_nbOwned);
+}
+
+void DistributedUniverse::applyInternInterractionsForces() {
+  runForceTasks(
+      _cells->getNbCells(),
+      [&](size_t cell) {
+        size_t nbParticles = _cells->getCellParticles(cell).size();
+        size_t nbSources = nbParticles;
+        for (size_t neighbour : _cells->getForwardNeighbours(cell)) {
+          nbSources += _cells->getCellParticles(neighbour).size();
+        }
+        return nbParticles * nbSources + 1.0;
+      },
+      [&](size_t cell, PairBatch& batch, std::vector<Vector>& forces) {
+        if (_cells->getCellParticles(cell).empty()) return;
+        applyHalfShellForces(cell, batch, forces);
+      });
+}
+
+double DistributedUniverse::sumCineticEnergy(double cineticEnergy) const {
+  MPI_Allreduce(MPI_IN_PLACE, &cineticEnergy, 1, MPI_DOUBLE, MPI_SUM, _comm);
+  return cineticEnergy;
+}
+
+/* ------------------------------- public ------------------------------- */
+
+DistributedUniverse::DistributedUniverse(Vector lowerBound, Vector upperBound,
+                                         double cellSide, MPI_Comm comm)
+    : FiniteUniverse(lowerBound, upperBound), _comm(comm), _cutoff(cellSide) {
+  if (cellSide <= 0) {
+    throw std::invalid_argument("Cell side must be positive.");
+  }
+  MPI_Comm_rank(comm, &_rank);
+  MPI_Comm_size(comm, &_nbRanks);
+
+  double width = upperBound[0] - lowerBound[0];
+  _nbColumns = std::max(static_cast<int>(std::floor(width / cellSide)), 1);
+  if (_nbColumns < _nbRanks) {
+    std::stringstream message;
+    message << "Universe has " << _nbColumns << " columns of cells for "
+            << _nbRanks << " processes, at least one column is needed "
+            << "for each process.";
+    throw std::invalid_argument(message.str());
+  }
+  _columnWidth = width / _nbColumns;
+
+  // Same number of columns for each process until particles are known
+  _slabStarts.resize(_nbRanks + 1);
+  for (int r = 0; r <= _nbRanks; r++) {
+    _slabStarts[r] = r * _nbColumns / _nbRanks;
+  }
+  _sendPackets.resize(_nbRanks);
+  createLocalCells();
+
+  if (_nbRanks > 1) {
+    setPastParticlesFileName("pastParticles_" + std::to_string(_rank) +
+                             ".trj");
+  }
+}
+
+size_t DistributedUniverse::getGlobalNbParticles() const {
+  unsigned long long nbParticles = getParticles().size();
+  MPI_Allreduce(MPI_IN_PLACE, &nbParticles, 1, MPI_UNSIGNED_LONG_LONG,
+                MPI_SUM, _comm);
+  return nbParticles;
+}
+
+void DistributedUniverse::simulateStormerVerlet(double timeStep,
+                                                double finalTime) {
+  if (getoobbehavior() == PERIODIC) {
+    throw std::invalid_argument(
+        "PERIODIC universes cannot be distributed between processes.");
+  }
+  if (getNbLevels() > 1) {
+    throw std::invalid_argument(
+        "Multiple time stepping is not supported by distributed universes.");
+  }
+  for (const Interaction& interaction : getInteractions()) {
+    if (interaction.getCutoff() > _cutoff) {
+      std::stringstream message;
+      message << "Cell side (" << _cutoff
+              << ") must be at least the largest cut-off radius ("
+              << interaction.getCutoff() << ").";
+      throw std::invalid_argument(message.str());
+    }
+  }
+
+  // Each process keeps the particles of its slab, then slabs are
+  // balanced (particles migrate at the first force computation)
+  const std::vector<Vector>& positions = getParticles().getPositions();
+  getParticles().removeIf(
+      [&](size_t i) { return ownerOf(columnOf(positions[i])) != _rank; });
+  rebalance();
+
+  FiniteUniverse::simulateStormerVerlet(timeStep, finalTime);
+}
@@ -0,0 +1,30 @@
+#include "external_force.hpp"
+
+#include <particle.hpp>
+
+/* ------------------------------- public ------------------------------- */
+
+void ExternalForce::applyOn(Particle& target) const {
+  if (const auto* field = std::get_if<GravityField>(&_kernel)) {
+    size_t coord = target.getDimension() - 1;
+    target.addToForceCoord(coord, -target.getMass() * field->G);
+  } else {
+    std::get<CustomForce>(_kernel).function(target);
+  }
+}
+
+void ExternalForce::applyOnAll(ParticleStore& particles) const {
+  if (const auto* field = std::get_if<GravityField>(&_kernel)) {
+    std::vector<Vector>& forces = particles.getForces();
+    const std::vector<double>& masses = particles.getMasses();
+    size_t coord = particles.getDimension() - 1;
+    for (size_t i = 0; i < particles.size(); i++) {
+      forces[i][coord] += -masses[i] * field->G;
+    }
+  } else {
+    for (size_t i = 0; i < particles.size(); i++) {
+      Particle target(particles, i);
+      std::get<CustomForce>(_kernel).function(target);
+    }
+  }
+}
@@ -0,0 +1,107 @@
+#include "fft.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <xassert.hpp>
+
+/* ------------------------------- intern ------------------------------- */
+
+static const double pi = std::acos(-1.0);
+
+/* ------------------------------- public ------------------------------- */
+
+FftPlan::FftPlan(size_t size) : _size(size) {
+  if (size == 0 || (size & (size - 1)) != 0) {
+    throw std::invalid_argument("FFT size must be a power of 2.");
+  }
+
+  size_t nbBits = 0;
+  while ((size_t(1) << nbBits) < size) nbBits++;
+  _bitReversal.resize(size);
+  for (size_t i = 0; i < size; i++) {
+    size_t reversed = 0;
+    for (size_t b = 0; b < nbBits; b++) {
+      reversed |= ((i >> b) & 1) << (nbBits - 1 - b);
+    }
+    _bitReversal[i] = reversed;
+  }
+
+  _twiddles.resize(size / 2);
+  for (size_t k = 0; k < size / 2; k++) {
+    _twiddles[k] = std::polar(1.0, -2 * pi * k / size);
+  }
+}
+
+void FftPlan::transform(std::complex<double>* data, bool inverse) const {
+  for (size_t i = 0; i < _size; i++) {
+    if (i < _bitReversal[i]) std::swap(data[i], data[_bitReversal[i]]);
+  }
+
+  // Butterflies of blocks of length 2, 4... size
+  for (size_t length = 2; length <= _size; length <<= 1) {
+    size_t half = length / 2;
+    size_t step = _size / length;
+    for (size_t block = 0; block < _size; block += length) {
+      for (size_t k = 0; k < half; k++) {
+        std::complex<double> twiddle = _twiddles[k * step];
+        if (inverse) twiddle = std::conj(twiddle);
+        std::complex<double> even = data[block + k];
+        std::complex<double> odd = data[block + k + half] * twiddle;
+        data[block + k] = even + odd;
+        data[block + k + half] = even - odd;
+      }
+    }
+  }
+}
+
+GridFft::GridFft(const std::vector<size_t>& dimensions)
+    : _dimensions(dimensions), _size(1) {
+  xassert(!dimensions.empty() && dimensions.size() <= 3,
+          "Grid dimension must be 1, 2 or 3.");
+  for (size_t nbPoints : dimensions) {
+    _plans.emplace_back(nbPoints);
+    _size *= nbPoints;
+  }
+}
+
+void GridFft::transform(std::vector<std::complex<double>>& grid, bool inverse,
+                        ThreadPool* pool) {
+  xassert(grid.size() == _size, "Grid must have the size of the transform.");
+  size_t nbThreads = pool ? pool->getNbThreads() : 1;
+  _lines.resize(nbThreads);
+
+  // Along dimension d, a line is made of points stride apart
+  size_t stride = 1;
+  for (size_t d = 0; d < _dimensions.size(); d++) {
+    size_t nbPoints = _dimensions[d];
+    size_t nbLines = _size / nbPoints;
+    const FftPlan& plan = _plans[d];
+
+    auto transformLines = [&](size_t first, size_t last, size_t thread) {
+      std::vector<std::complex<double>>& line = _lines[thread];
+      line.resize(nbPoints);
+      for (size_t l = first; l < last; l++) {
+        size_t start = l % stride + (l / stride) * stride * nbPoints;
+        if (stride == 1) {
+          plan.transform(grid.data() + start, inverse);
+          continue;
+        }
+        for (size_t k = 0; k < nbPoints; k++) {
+          line[k] = grid[start + k * stride];
+        }
+        plan.transform(line.data(), inverse);
+        for (size_t k = 0; k < nbPoints; k++) {
+          grid[start + k * stride] = line[k];
+        }
+      }
+    };
+    if (pool) {
+      size_t grain = (nbLines + 4 * nbThreads - 1) / (4 * nbThreads);
+      pool->parallelFor(nbLines, grain, transformLines);
+    } else {
+      transformLines(0, nbLines, 0);
+    }
+    stride *= nbPoints;
+  }
+}
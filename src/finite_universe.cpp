@@ -1,5 +1,6 @@
 #include <cmath>
 #include <finite_universe.hpp>
+#include <stdexcept>
 #include <xassert.hpp>
 
 #include "forces.hpp"
@@ -7,9 +8,7 @@
 /* ------------------------------- private ------------------------------- */
 
 void FiniteUniverse::applyWallsForces() {
-  for (Particle& p : getParticles()) {
-    _wallsForce.applyOn(p);
-  }
+  _wallsForce.applyOnAll(getParticles());
 }
 
 void FiniteUniverse::applyForeignNeighboursForces() {
@@ -19,7 +18,8 @@ void FiniteUniverse::applyForeignNeighboursForces() {
 void FiniteUniverse::applyExternalForces() {
   Universe::applyExternalForces();
 
-  if (_applyWallsForce) {
+  // Walls force is slow, computed with the first level
+  if (_applyWallsForce && isLevelActive(0)) {
     applyWallsForces();
   }
 }
@@ -46,48 +46,19 @@ std::pair<Vector, Vector> FiniteUniverse::getBounds() const {
 }
 
 void FiniteUniverse::removeOutOfBoundsParticles() {
-  std::list<Particle>& particles = getParticles();
-  auto it = particles.begin();
-  while (it != particles.end()) {
-    if (isInBounds(*it)) {
-      it++;
-    } else {
-      it = particles.erase(it);
-    }
-  }
+  ParticleStore& particles = getParticles();
+  const std::vector<Vector>& positions = particles.getPositions();
+  particles.removeIf([this, &positions](size_t i) {
+    return !positions[i].isInBounds(_lowerBound, _upperBound);
+  });
 }
 
 void FiniteUniverse::reflectOutOfBoundsParticles() {
-  size_t dim = getDimension();
-  for (Particle& p : getParticles()) {
-    for (size_t i = 0; i < dim; i++) {
-      double coordValue = p.getPosition()[i];
-      while (coordValue < _lowerBound[i] || coordValue > _upperBound[i]) {
-        double boundValue =
-            (coordValue < _lowerBound[i]) ? _lowerBound[i] : _upperBound[i];
-        p.invertSpeed(i);
-        coordValue = 2 * boundValue - coordValue;
-        p.setPosCoord(i, coordValue);
-      }
-    }
-    xassert(isInBounds(p), "particle should not be out of bounds anymore.");
-  }
+  getKernels().reflectOutOfBounds(getParticles(), _lowerBound, _upperBound);
 }
 
 void FiniteUniverse::teleportOutOfBoundsParticles() {
-  size_t dim = getDimension();
-  for (Particle& p : getParticles()) {
-    for (size_t i = 0; i < dim; i++) {
-      double coordValue = p.getPosition()[i];
-      if (coordValue < _lowerBound[i] || coordValue > _upperBound[i]) {
-        double divisor = _upperBound[i] - _lowerBound[i];
-        coordValue = std::fmod(
-            std::fmod(coordValue - _lowerBound[i], divisor) + divisor, divisor);
-        p.setPosCoord(i, coordValue);
-      }
-    }
-    xassert(isInBounds(p), "particle should not be out of bounds anymore.");
-  }
+  getKernels().teleportOutOfBounds(getParticles(), _lowerBound, _upperBound);
 }
 
 void FiniteUniverse::handleOutOfBoundsParticles() {
@@ -131,6 +102,14 @@ void FiniteUniverse::updatePositions(double timeStep) {
   handleOutOfBoundsParticles();
 }
 
+void FiniteUniverse::simulateStormerVerlet(double timeStep, double finalTime) {
+  if (getMaxBlockLevel() > 0) {
+    throw std::invalid_argument(
+        "Block time steps are not supported by finite universes.");
+  }
+  Universe::simulateStormerVerlet(timeStep, finalTime);
+}
+
 std::ostream& operator<<(std::ostream& strm, FiniteUniverse universe) {
   strm << "FiniteUniverse" << std::endl
        << "   dimension: " << universe.getDimension() << std::endl
@@ -150,8 +129,7 @@ void FiniteUniverse::addParticle(Vector pos, Vector speed, double mass,
 bool FiniteUniverse::isInBounds(const Particle& p) {
   xassert(getDimension() == p.getDimension(),
           "Particle and universe must have same dimension.");
-  Vector position = p.getPosition();
-  return position.isInBounds(_lowerBound, _upperBound);
+  return p.getPosition().isInBounds(_lowerBound, _upperBound);
 }
 
 void FiniteUniverse::setOOBBehavior(OOBBehavior lb) {
@@ -1,30 +1,109 @@
 #include "forces.hpp"
 
 #include <cmath>
+#include <limits>
+#include <stdexcept>
 #include <particle.hpp>
+#include <particle_pair_kernel.hpp>
 #include <vector.hpp>
 #include <xassert.hpp>
 
+/* ------------------------------- intern ------------------------------- */
+
+static const double noCutoff = std::numeric_limits<double>::infinity();
+
+static LennardJonesParameters lennardJonesParameters(double epsilon,
+                                                     double sigma,
+                                                     double forceShift,
+                                                     double cutoff) {
+  double sigma2 = sigma * sigma;
+  return LennardJonesParameters{epsilon, sigma2 * sigma2 * sigma2, forceShift,
+                                cutoff * cutoff};
+}
+
+/* ------------------------------- public ------------------------------- */
+
 void gravitationalInteraction(const Particle& source, Particle& target) {
-  xassert(&source != &target,
+  xassert(!source.isSameParticle(target),
           "Cannot compute force if particles given are the same.");
-  double r = source.distanceTo(target);
-  Vector force = source.getPosition();
-  force -= target.getPosition();
-  force *= (source.getMass() * target.getMass() / std::pow(r, 3));
-  target.addToForce(force);
+  double massProduct = source.getMass() * target.getMass();
+  applyPairKernel(source, target, nullptr, [&](double squaredDistance) {
+    return gravitationalFactor(squaredDistance, massProduct,
+                               GravitationalParameters{noCutoff});
+  });
 }
 
 void lennardJonesInteraction(const Particle& source, Particle& target,
                              double epsilon, double sigma) {
-  xassert(&source != &target,
+  xassert(!source.isSameParticle(target),
           "Cannot compute force if particles given are the same.");
-  double r = source.distanceTo(target);
-  double power_6_term = pow(sigma / r, 6);
-  Vector force = source.getPosition();  // Copy
-  force -= target.getPosition();
-  force *= 24 * epsilon * 1 / pow(r, 2) * power_6_term * (1 - 2 * power_6_term);
-  target.addToForce(force);
+  LennardJonesParameters params =
+      lennardJonesParameters(epsilon, sigma, 0, noCutoff);
+  applyPairKernel(source, target, nullptr, [&](double squaredDistance) {
+    return lennardJonesFactor(squaredDistance, params);
+  });
+}
+
+void gravitationalPairInteraction(Particle& first, Particle& second) {
+  xassert(!first.isSameParticle(second),
+          "Cannot compute force if particles given are the same.");
+  double massProduct = first.getMass() * second.getMass();
+  applyPairKernel(first, second, &first, [&](double squaredDistance) {
+    return gravitationalFactor(squaredDistance, massProduct,
+                               GravitationalParameters{noCutoff});
+  });
+}
+
+void lennardJonesPairInteraction(Particle& first, Particle& second,
+                                 double epsilon, double sigma) {
+  xassert(!first.isSameParticle(second),
+          "Cannot compute force if particles given are the same.");
+  LennardJonesParameters params =
+      lennardJonesParameters(epsilon, sigma, 0, noCutoff);
+  applyPairKernel(first, second, &first, [&](double squaredDistance) {
+    return lennardJonesFactor(squaredDistance, params);
+  });
+}
+
+Interaction makeGravitationalInteraction(double cutoff) {
+  if (cutoff <= 0) {
+    throw std::invalid_argument("Cut-off radius must be positive.");
+  }
+  return Interaction(GravitationalParameters{cutoff * cutoff}, cutoff);
+}
+
+Interaction makeShortRangeGravitationalInteraction(double splitScale,
+                                                   double cutoff) {
+  if (splitScale <= 0) {
+    throw std::invalid_argument("Split scale must be positive.");
+  }
+  if (cutoff <= 0) {
+    throw std::invalid_argument("Cut-off radius must be positive.");
+  }
+  return Interaction(GravitationalParameters{cutoff * cutoff, splitScale},
+                     cutoff);
+}
+
+Interaction makeLennardJonesInteraction(double epsilon, double sigma,
+                                        double cutoff, bool shiftForce) {
+  if (cutoff <= 0) {
+    throw std::invalid_argument("Cut-off radius must be positive.");
+  }
+
+  // Norm of the force at the cut-off radius
+  double forceShift = 0;
+  if (shiftForce) {
+    LennardJonesParameters unshifted =
+        lennardJonesParameters(epsilon, sigma, 0, noCutoff);
+    forceShift = lennardJonesFactor(cutoff * cutoff, unshifted) * cutoff;
+  }
+
+  return Interaction(
+      lennardJonesParameters(epsilon, sigma, forceShift, cutoff), cutoff);
+}
+
+ExternalForce makeGravitationalForce(double G) {
+  return ExternalForce(GravityField{G});
 }
 
 void gravitationalForce(Particle& target, double G) {
@@ -3,324 +3,238 @@
 #include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 #include <xassert.hpp>
 
-#include "extern_border_cell.hpp"
-#include "intern_cell.hpp"
-#include "progressbar.hpp"
+#include "forces.hpp"
 
-/* ------------------------------- intern (for checking asserts)
- * ------------------------------- */
+/* ------------------------------- intern ------------------------------- */
 
-bool isExternCoord(const std::vector<int>& coords,
-                   const std::vector<int>& dimensions) {
-  for (size_t i = 0; i < dimensions.size(); i++) {
-    if (coords[i] == -1 || coords[i] == dimensions[i]) {
-      return true;
-    }
-  }
-  return false;
-}
+/* Cut-off radius of the short-range gravitation in split scales:
+   the force neglected beyond is 0.6 % of the gravitation */
+static const double cutoffOverSplitScale = 5;
 
-bool isInternCoord(const std::vector<int>& coords,
-                   const std::vector<int>& dimensions) {
-  for (size_t i = 0; i < dimensions.size(); i++) {
-    if (coords[i] < 0 || coords[i] >= dimensions[i]) {
-      return false;
-    }
-  }
-  return true;
+/* Weights are the number of pairs of a task, plus one for the cost
+   of visiting the task even if it has no pair */
+
+static double rowWeight(const NeighbourRows& rows, size_t row) {
+  return rows.getNeighbours(row).size() + 1;
 }
 
 /* ------------------------------- private ------------------------------- */
 
-void GriddedUniverse::createExternBorderCell(std::vector<int>& coords,
-                                             InternCell* copyCell) {
-  xassert(coords.size() == _dimensions.size(), "Dimensions must match.");
-  xassert(isExternCoord(coords, _dimensions),
-          "Coords should be an external coord.");
-
-  Vector offset(_dimensions.size());
-  Vector universeSizes = getUpperBound();
-  universeSizes -= getLowerBound();
-  for (size_t i = 0; i < _dimensions.size(); i++) {
-    if (coords[i] == -1) {
-      offset[i] -= universeSizes[i];
-    } else if (coords[i] == _dimensions[i]) {
-      offset[i] += universeSizes[i];
-    }
+double GriddedUniverse::cellWeight(size_t cell) const {
+  size_t nbParticles = _cells.getCellParticles(cell).size();
+  size_t nbSources = nbParticles;
+  IndexSpan neighbours = _halfShell ? _cells.getForwardNeighbours(cell)
+                                    : _cells.getNeighbours(cell);
+  for (size_t neighbour : neighbours) {
+    nbSources += _cells.getCellParticles(neighbour).size();
   }
-
-  xassert(offset != Vector(_dimensions.size()),
-          std::stringstream()
-              << "offset shouldn't be zero. offset = " << offset);
-  _externBorderCells.emplace_back(getDimension(), this, coords, offset,
-                                  copyCell);
+  return nbParticles * nbSources + 1;
 }
 
-void GriddedUniverse::createInternCellsRecursive(std::vector<int>& coordinates,
-                                                 int depth) {
-  if (depth == -1) {
-    xassert(isInternCoord(coordinates, _dimensions),
-            "Must have intern coordinates.");
-    _internCells.emplace_back(InternCell(getDimension(), this, coordinates));
-    return;
-  }
-
-  // Loop through the current dimension
-  for (int i = 0; i < _dimensions[depth]; ++i) {
-    coordinates[depth] = i;
-    createInternCellsRecursive(coordinates, depth - 1);
+double GriddedUniverse::borderCellWeight(size_t borderCell) const {
+  size_t nbGhosts =
+      _cells.getGhostStart(borderCell + 1) - _cells.getGhostStart(borderCell);
+  size_t nbTargets = 0;
+  for (size_t neighbour : _cells.getBorderNeighbours(borderCell)) {
+    nbTargets += _cells.getCellParticles(neighbour).size();
   }
+  return nbGhosts * nbTargets + 1;
 }
 
-void GriddedUniverse::createExternCellsRecursive(std::vector<int>& coordinates,
-                                                 int depth) {
-  if (depth == -1) {
-    bool isBorder = false;
-    for (size_t i = 0; i < _dimensions.size(); ++i) {
-      if (coordinates[i] == -1 || coordinates[i] == _dimensions[i]) {
-        isBorder = true;
-        break;
-      }
+void GriddedUniverse::applyHalfShellForces(size_t cell, PairBatch& batch,
+                                           std::vector<Vector>& forces) {
+  ParticleStore& particles = getParticles();
+  const std::vector<Interaction>& interactions = getActiveInteractions();
+  IndexSpan cellParticles = _cells.getCellParticles(cell);
+  for (const size_t* i = cellParticles.begin(); i != cellParticles.end();
+       i++) {
+    // Next particles of the cell, and particles of forward neighbours
+    batch.clear();
+    batch.addSources(IndexSpan(i + 1, cellParticles.end()));
+    for (size_t neighbour : _cells.getForwardNeighbours(cell)) {
+      batch.addSources(_cells.getCellParticles(neighbour));
     }
-
-    if (isBorder) {
-      xassert(isExternCoord(coordinates, _dimensions), "Not extern coord.");
-      std::vector<int> copyCellCoords(coordinates.size());
-      for (size_t i = 0; i < coordinates.size(); i++) {
-        if (coordinates[i] == _dimensions[i]) {
-          copyCellCoords[i] = 0;
-        } else if (coordinates[i] == -1) {
-          copyCellCoords[i] = _dimensions[i] - 1;
-        } else {
-          copyCellCoords[i] = coordinates[i];
-        }
-      }
-
-      xassert(isInternCoord(copyCellCoords, _dimensions),
-              "Must have intern coordinates.");
-      InternCell* copyCell = &_internCells.at(internCellIndex(copyCellCoords));
-      createExternBorderCell(coordinates, copyCell);
-    }
-    return;
-  }
-
-  // Extend the range to include negative and beyond bounds
-  for (int i = -1; i <= _dimensions[depth]; ++i) {
-    coordinates[depth] = i;
-    createExternCellsRecursive(coordinates, depth - 1);
+    batch.applyForces(particles, *i, particles, interactions, true, forces);
   }
 }
 
-void GriddedUniverse::cellsCreation() {
-  // Computes how many cells we need for each dimension
-  Vector universeSizes = getUpperBound();
-  universeSizes -= getLowerBound();
-  for (size_t i = 0; i < getDimension(); i++) {
-    _dimensions.push_back(
-        static_cast<size_t>(std::ceil(universeSizes[i] / _cellSide)));
-  }
-
-  // Initial coords to 0
-  std::vector<int> coords(_dimensions.size(), 0);
-
-  // Creates intern cells
-  createInternCellsRecursive(coords, _dimensions.size() - 1);
-
-  // Creates extern cells
-  createExternCellsRecursive(coords, _dimensions.size() - 1);
-}
-
-inline bool GriddedUniverse::areNeighbours(std::vector<int> coord1,
-                                           std::vector<int> coord2) {
-  xassert(coord1.size() == coord2.size(), "Coords dimensions must match");
-  for (size_t d = 0; d < coord1.size(); d++) {
-    if (abs(coord1[d] - coord2[d]) > 1) {
-      return false;
+void GriddedUniverse::applyFullShellForces(size_t cell, PairBatch& batch,
+                                           std::vector<Vector>& forces) {
+  ParticleStore& particles = getParticles();
+  const std::vector<Interaction>& interactions = getActiveInteractions();
+  IndexSpan cellParticles = _cells.getCellParticles(cell);
+  for (const size_t* t = cellParticles.begin(); t != cellParticles.end();
+       t++) {
+    // Other particles of the cell, and particles of all neighbours
+    batch.clear();
+    batch.addSources(IndexSpan(cellParticles.begin(), t));
+    batch.addSources(IndexSpan(t + 1, cellParticles.end()));
+    for (size_t neighbour : _cells.getNeighbours(cell)) {
+      batch.addSources(_cells.getCellParticles(neighbour));
     }
+    batch.applyForces(particles, *t, particles, interactions, false, forces);
   }
-  return true;
 }
 
-void GriddedUniverse::setCellsNeighbours() {
-  xassert(_internCells.size() > 0, "There is no cell to add neighbour to.");
-
-#ifdef SHOW_PROGRESS_INFOS
-  std::cerr << "Assigning cells neighbours ";
-  Progressbar bar(_internCells.size() + _externBorderCells.size());
-#endif
+void GriddedUniverse::applyVerletListForces() {
+  ParticleStore& particles = getParticles();
+  const std::vector<Interaction>& interactions = getActiveInteractions();
+  const NeighbourRows& rows = _verletList->getRows();
+  runForceTasks(rows.size(), [&](size_t r) { return rowWeight(rows, r); },
+                [&](size_t r, PairBatch& batch, std::vector<Vector>& forces) {
+                  batch.clear();
+                  batch.addSources(rows.getNeighbours(r));
+                  batch.applyForces(particles, rows.particles[r], particles,
+                                    interactions, true, forces);
+                });
+}
 
-  for (size_t i = 0; i < _internCells.size(); i++) {
-    setOneInernCellNeighbours(_internCells[i]);
+void GriddedUniverse::applyVerletListGhostForces() {
+  ParticleStore& particles = getParticles();
+  ParticleStore& ghosts = _cells.getGhosts();
+  const std::vector<Interaction>& interactions = getActiveInteractions();
+  const NeighbourRows& rows = _verletList->getGhostRows();
+  runForceTasks(rows.size(), [&](size_t r) { return rowWeight(rows, r); },
+                [&](size_t r, PairBatch& batch, std::vector<Vector>& forces) {
+                  batch.clear();
+                  batch.addSources(rows.getNeighbours(r));
+                  batch.applyForces(particles, rows.particles[r], ghosts,
+                                    interactions, false, forces);
+                });
+}
 
-#ifdef SHOW_PROGRESS_INFOS
-    bar.update();
-#endif
+void GriddedUniverse::applyInternInterractionsForces() {
+  if (_verletList) {
+    applyVerletListForces();
+    return;
   }
 
-  for (size_t i = 0; i < _externBorderCells.size(); i++) {
-    setOneExternCellNeighbours(_externBorderCells[i]);
+  runForceTasks(
+      _cells.getNbCells(), [&](size_t cell) { return cellWeight(cell); },
+      [&](size_t cell, PairBatch& batch, std::vector<Vector>& forces) {
+        if (_cells.getCellParticles(cell).empty()) return;
 
-#ifdef SHOW_PROGRESS_INFOS
-    bar.update();
-#endif
-  }
+        if (_halfShell) {
+          applyHalfShellForces(cell, batch, forces);
+        } else {
+          applyFullShellForces(cell, batch, forces);
+        }
+      });
 }
 
-void GriddedUniverse::setOneExternCellNeighbours(ExternBorderCell& borderCell) {
-  // Get the coordinates of the current cell
-  const std::vector<int> coordinates = borderCell.getCoordinates();
-
-  // Set neighboring cells
-  for (InternCell& potentialNeighbour : _internCells) {
-    // Get coordinates of potential neighbour
-    const std::vector<int>& neighborCoordinates =
-        potentialNeighbour.getCoordinates();
-
-    // Add to cell's neighbours if is neighbour
-    if (areNeighbours(coordinates, neighborCoordinates)) {
-      borderCell.addNeighbour(&potentialNeighbour);
-    }
+void GriddedUniverse::applyForeignNeighboursForces() {
+  if (_verletList) {
+    applyVerletListGhostForces();
+    return;
   }
 
-  xassert(borderCell.getNbNeighbours() > 0 &&
-              borderCell.getNbNeighbours() < getDimension() * getDimension(),
-          "ExternCell don't have a correct number of neighbours.");
+  ParticleStore& particles = getParticles();
+  ParticleStore& ghosts = _cells.getGhosts();
+  const std::vector<Interaction>& interactions = getActiveInteractions();
+  runForceTasks(
+      _cells.getNbBorderCells(), [&](size_t b) { return borderCellWeight(b); },
+      [&](size_t b, PairBatch& batch, std::vector<Vector>& forces) {
+        size_t ghostsBegin = _cells.getGhostStart(b);
+        size_t ghostsEnd = _cells.getGhostStart(b + 1);
+        if (ghostsBegin == ghostsEnd) return;
+
+        for (size_t neighbour : _cells.getBorderNeighbours(b)) {
+          for (size_t t : _cells.getCellParticles(neighbour)) {
+            batch.clear();
+            batch.addSourceRange(ghostsBegin, ghostsEnd);
+            batch.applyForces(particles, t, ghosts, interactions, false,
+                              forces);
+          }
+        }
+      });
 }
 
-void GriddedUniverse::setOneInernCellNeighbours(InternCell& internCell) {
-  // Get the coordinates of the current cell
-  const std::vector<int> coordinates = internCell.getCoordinates();
-
-  // Set neighboring cells
-  for (InternCell& potentialNeighbour : _internCells) {
-    // Skip current cell
-    if (&internCell == &potentialNeighbour) {
-      continue;
-    }
+void GriddedUniverse::applyInteractionForces() {
+  FiniteUniverse::applyInteractionForces();
 
-    // Get coordinates of potential neighbour
-    const std::vector<int>& neighborCoordinates =
-        potentialNeighbour.getCoordinates();
-
-    // Add to cell's neighbours if is neighbour
-    if (areNeighbours(coordinates, neighborCoordinates)) {
-      internCell.addNeighbour(&potentialNeighbour);
-    }
+  // Long-range forces are slow, computed with the first level
+  if (_particleMesh && isLevelActive(0)) {
+    _particleMesh->applyForces(getParticles(), getThreadPool());
   }
 }
 
-size_t GriddedUniverse::internCellIndex(std::vector<int> coordinates) {
-  xassert(coordinates.size() == getDimension(),
-          "Coordinates an gridded universe dimensions must match.");
+void GriddedUniverse::fillCells() {
+  _cells.fill(getParticles(), getThreadPool());
 
-  size_t index = 0;
-  size_t multiplier = 1;
-  for (size_t i = 0; i < _dimensions.size(); i++) {
-    index += coordinates[i] * multiplier;
-    multiplier *= _dimensions[i];
+  if (getoobbehavior() == PERIODIC) {
+    _cells.fillGhosts(getParticles(), getThreadPool());
+  } else {
+    _cells.clearGhosts();
   }
-  xassert(index < _internCells.size(), std::stringstream()
-                                           << "index out of bounds, maximum is "
-                                           << _internCells.size() << ", got "
-                                           << index << ".");
-  return index;
 }
 
-/* Calculates the coordinates of the cell which constains
-   the positions vector.
-   For value in each vector dimension:
-        - if the value is not at the upper bound, we divide the distance
-          to the lower bound by the cellSide and we have the index,
-        - if we do the same when the value is at upper bound, we will
-          get an out of bounds index. So we decrease the index by 1. */
-std::vector<int> GriddedUniverse::correspondingCellCoordonates(
-    const Vector& pos) {
-  xassert(
-      pos.isInBounds(getLowerBound(), getUpperBound()),
-      std::stringstream()
-          << "Position has to be inside the bounds of the gridded universe. "
-          << "Bounds: " << getLowerBound() << ", " << getUpperBound() << ". "
-          << "Position: " << pos << ".");
-
-  std::vector<int> coordinates;
-  for (size_t i = 0; i < getDimension(); ++i) {
-    int coord = static_cast<int>((pos[i] - getLowerBound()[i]) / _cellSide);
-    if (pos[i] == getUpperBound()[i]) coord--;
-    xassert(
-        coord < _dimensions[i],
-        std::stringstream()
-            << "Particle corresponding cell coordinate calculated on dimension "
-            << i << " is too big. "
-            << "On this dimension, maximum cell coordinate is "
-            << _dimensions[i] - 1 << ", found " << coord << ".");
-    coordinates.push_back(coord);
+void GriddedUniverse::setupCells() {
+  double largestCutoff = 0;
+  for (const Interaction& interaction : getInteractions()) {
+    if (interaction.hasCutoff()) {
+      largestCutoff = std::max(largestCutoff, interaction.getCutoff());
+    }
   }
-  return coordinates;
-}
-
-void GriddedUniverse::putInCorrespondingCell(Particle* p) {
-  // Computes coordinates of the cell containing the particle
-  std::vector<int> coordinates = correspondingCellCoordonates(p->getPosition());
 
-  // Get the index of the cell
-  size_t index = internCellIndex(coordinates);
-  xassert(index < _internCells.size(),
-          std::stringstream() << "Cell index calculated is out of bounds. "
-                              << "Index is " << index << " while there is "
-                              << _internCells.size() << " cells.");
-
-  // Adds the particle in the corresponding cell
-  _internCells[index].addParticle(p);
-}
-
-void GriddedUniverse::applyInternInterractionsForces() {
-  for (InternCell& cell : _internCells) {
-    cell.applyForceOnNeighbours();
-    cell.computeInternInterractions();
+  if (_deriveCellSide) {
+    if (largestCutoff == 0) {
+      throw std::runtime_error(
+          "Cell side cannot be derived: no interaction has a cut-off "
+          "radius.");
+    }
+    _cutoff = largestCutoff;
+  } else if (largestCutoff > _cutoff) {
+    std::stringstream message;
+    message << "Cell side (" << _cutoff
+            << ") must be at least the largest cut-off radius ("
+            << largestCutoff << ").";
+    throw std::invalid_argument(message.str());
   }
-}
 
-void GriddedUniverse::applyForeignNeighboursForces() {
-  for (const ExternBorderCell& cell : _externBorderCells) {
-    cell.applyForceOnNeighbours();
+  if (_meshSplitScale > 0) {
+    if (getoobbehavior() != PERIODIC) {
+      throw std::invalid_argument(
+          "Periodic gravitation needs a PERIODIC universe.");
+    }
+    _particleMesh.emplace(getLowerBound(), getUpperBound(), _meshSplitScale);
   }
-}
 
-void GriddedUniverse::clearCells() {
-  for (Cell& cell : _internCells) {
-    cell.clearParticles();
+  double cellSide = _cutoff;
+  if (_verletSkin > 0) {
+    _verletList.emplace(_cutoff, _verletSkin);
+    cellSide += _verletSkin;
   }
-
-  if (getoobbehavior() == PERIODIC) {
-    for (Cell& cell : _externBorderCells) {
-      cell.clearParticles();
-    }
+  if (cellSide != _cells.getCellSide()) {
+    _cells.setCellSide(cellSide);
   }
 }
 
-void GriddedUniverse::fillCells() {
-  for (Particle& p : getParticles()) {
-    putInCorrespondingCell(&p);
-  }
-
-  if (getoobbehavior() == PERIODIC) {
-    for (ExternBorderCell& cell : _externBorderCells) {
-      cell.copyParticles();
+void GriddedUniverse::updateVerletList() {
+  if (!_verletList->needsRebuild(getParticles())) {
+    if (getoobbehavior() == PERIODIC) {
+      _cells.refreshGhosts(getParticles(), getThreadPool());
     }
+    return;
   }
+
+  fillCells();
+  _verletList->build(getParticles(), _cells);
 }
 
 void GriddedUniverse::updatePositions(double timeStep) {
   // Updates positions and deal with out of bounds particles (linear complexity)
   FiniteUniverse::updatePositions(timeStep);
 
-  // Clear cells from particle pointers (linear complexity)
-  clearCells();
+  if (_verletList) {
+    updateVerletList();
+    return;
+  }
 
-  // Fill cells with particles pointers (linear)
+  // Fill cells with particles indices (linear)
   fillCells();
 }
 
@@ -328,9 +242,35 @@ void GriddedUniverse::updatePositions(double timeStep) {
 
 GriddedUniverse::GriddedUniverse(Vector lowerBound, Vector upperBound,
                                  double cellSide)
-    : FiniteUniverse(lowerBound, upperBound), _cellSide(cellSide) {
-  cellsCreation();
-  setCellsNeighbours();
+    : FiniteUniverse(lowerBound, upperBound),
+      _cells(lowerBound, upperBound, cellSide, getKernels()),
+      _cutoff(cellSide),
+      _deriveCellSide(false) {}
+
+GriddedUniverse::GriddedUniverse(Vector lowerBound, Vector upperBound)
+    : FiniteUniverse(lowerBound, upperBound),
+      // A single cell until the cell side is known
+      _cells(lowerBound, upperBound, norm(upperBound - lowerBound),
+             getKernels()),
+      _cutoff(0),
+      _deriveCellSide(true) {}
+
+void GriddedUniverse::activateVerletList(double skin) {
+  if (skin <= 0) {
+    throw std::invalid_argument("Verlet list skin must be positive.");
+  }
+  _verletSkin = skin;
+}
+
+void GriddedUniverse::addPeriodicGravitation(double cutoff,
+                                             size_t shortRangeLevel) {
+  if (getDimension() != 3) {
+    throw std::invalid_argument("Periodic gravitation needs dimension 3.");
+  }
+  double splitScale = cutoff / cutoffOverSplitScale;
+  addInteraction(makeShortRangeGravitationalInteraction(splitScale, cutoff),
+                 shortRangeLevel);
+  _meshSplitScale = splitScale;
 }
 
 std::ostream& operator<<(std::ostream& strm, GriddedUniverse universe) {
@@ -338,10 +278,10 @@ std::ostream& operator<<(std::ostream& strm, GriddedUniverse universe) {
        << "   dimension: " << universe.getDimension() << std::endl
        << "   lower bound: " << universe.getLowerBound() << std::endl
        << "   upper bound: " << universe.getUpperBound() << std::endl
-       << "   cell side: " << universe._cellSide << std::endl
+       << "   cell side: " << universe._cells.getCellSide() << std::endl
        << "   number of cell on each dimension: ";
 
-  for (size_t nb : universe._dimensions) {
+  for (size_t nb : universe.getDimensions()) {
     strm << nb << " ";
   }
 
@@ -351,7 +291,10 @@ std::ostream& operator<<(std::ostream& strm, GriddedUniverse universe) {
 }
 
 void GriddedUniverse::simulateStormerVerlet(double timeStep, double finalTime) {
-  clearCells();
+  setupCells();
   fillCells();
+  if (_verletList) {
+    _verletList->build(getParticles(), _cells);
+  }
   FiniteUniverse::simulateStormerVerlet(timeStep, finalTime);
-}
\ No newline at end of file
+}
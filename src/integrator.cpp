@@ -0,0 +1,73 @@
+#include "integrator.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+/* ------------------------------- intern ------------------------------- */
+
+/* Sum of the coefficients, checked to be 1 */
+static double sum(const std::vector<double>& coefficients) {
+  double total = 0;
+  for (double coefficient : coefficients) total += coefficient;
+  return total;
+}
+
+/* ------------------------------- public ------------------------------- */
+
+Integrator::Integrator(const std::string& name, size_t order,
+                       const std::vector<double>& kicks,
+                       const std::vector<double>& drifts)
+    : _name(name), _order(order), _kicks(kicks), _drifts(drifts) {
+  if (drifts.empty() || kicks.size() != drifts.size() + 1) {
+    throw std::invalid_argument(
+        "An integrator needs one more kick than drifts.");
+  }
+  if (std::abs(sum(kicks) - 1) > 1e-12 || std::abs(sum(drifts) - 1) > 1e-12) {
+    throw std::invalid_argument(
+        "Kicks and drifts coefficients must each sum to 1.");
+  }
+}
+
+size_t Integrator::getNbForceComputations() const {
+  // Every kick after a drift, and the first one if the step
+  // ends with a drift
+  size_t nbComputations = 0;
+  for (size_t k = 1; k < _kicks.size(); k++) {
+    if (_kicks[k] != 0) nbComputations++;
+  }
+  if (_kicks.front() != 0 && _kicks.back() == 0) nbComputations++;
+  return nbComputations;
+}
+
+bool Integrator::isVelocityVerlet() const {
+  return _drifts.size() == 1 && _kicks[0] == 0.5 && _kicks[1] == 0.5;
+}
+
+Integrator makeVelocityVerletIntegrator() {
+  return Integrator("velocity Verlet", 2, {0.5, 0.5}, {1});
+}
+
+Integrator makeYoshida4Integrator() {
+  double cubeRoot = std::cbrt(2.0);
+  double w1 = 1 / (2 - cubeRoot);
+  double w0 = -cubeRoot / (2 - cubeRoot);
+  return Integrator("Yoshida 4", 4,
+                    {w1 / 2, (w1 + w0) / 2, (w0 + w1) / 2, w1 / 2},
+                    {w1, w0, w1});
+}
+
+Integrator makeForestRuthIntegrator() {
+  double theta = 1 / (2 - std::cbrt(2.0));
+  return Integrator("Forest-Ruth", 4, {0, theta, 1 - 2 * theta, theta, 0},
+                    {theta / 2, (1 - theta) / 2, (1 - theta) / 2, theta / 2});
+}
+
+Integrator makeOmelyanIntegrator() {
+  double xi = 0.1786178958448091;
+  double lambda = -0.2123418310626054;
+  double chi = -0.6626458266981849e-1;
+  return Integrator("Omelyan", 4,
+                    {0, (1 - 2 * lambda) / 2, lambda, lambda,
+                     (1 - 2 * lambda) / 2, 0},
+                    {xi, chi, 1 - 2 * (chi + xi), chi, xi});
+}
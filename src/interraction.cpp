@@ -0,0 +1,91 @@
+#include "interraction.hpp"
+
+#include <particle.hpp>
+#include <particle_pair_kernel.hpp>
+#include <type_traits>
+#include <variant>
+#include <vector.hpp>
+
+/* ------------------------------- intern ------------------------------- */
+
+/**
+ * @brief Factor of a built-in kernel for a pair:
+ *        force on target is (source - target) * factor
+ */
+static inline double builtinFactor(const LennardJonesParameters& params,
+                                   double squaredDistance, const Particle&,
+                                   const Particle&) {
+  return lennardJonesFactor(squaredDistance, params);
+}
+
+static inline double builtinFactor(const GravitationalParameters& params,
+                                   double squaredDistance,
+                                   const Particle& source,
+                                   const Particle& target) {
+  return gravitationalFactor(squaredDistance,
+                             source.getMass() * target.getMass(), params);
+}
+
+/**
+ * @brief Applies a built-in kernel on target, and on reaction
+ *        if it is not null
+ */
+template <class Params>
+static void applyBuiltin(const Params& params, const Particle& source,
+                         Particle& target, Particle* reaction) {
+  applyPairKernel(source, target, reaction, [&](double squaredDistance) {
+    return builtinFactor(params, squaredDistance, source, target);
+  });
+}
+
+/* ------------------------------- public ------------------------------- */
+
+bool Interaction::isReciprocal() const {
+  const auto* custom = std::get_if<CustomInteraction>(&_kernel);
+  return !custom || static_cast<bool>(custom->pairFunction);
+}
+
+bool Interaction::isInRange(const Particle& first,
+                            const Particle& second) const {
+  return squaredNorm(first.getPosition() - second.getPosition()) <
+         _squaredCutoff;
+}
+
+void Interaction::operator()(const Particle& source, Particle& target) const {
+  if (hasCutoff() && !isInRange(source, target)) return;
+
+  if (const auto* custom = std::get_if<CustomInteraction>(&_kernel)) {
+    custom->function(source, target);
+    return;
+  }
+  std::visit(
+      [&](const auto& params) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(params)>,
+                                      CustomInteraction>) {
+          applyBuiltin(params, source, target, nullptr);
+        }
+      },
+      _kernel);
+}
+
+void Interaction::applyOnPair(Particle& first, Particle& second) const {
+  if (hasCutoff() && !isInRange(first, second)) return;
+
+  if (const auto* custom = std::get_if<CustomInteraction>(&_kernel)) {
+    if (custom->pairFunction) {
+      custom->pairFunction(first, second);
+    } else {
+      custom->function(first, second);
+      custom->function(second, first);
+    }
+    return;
+  }
+  std::visit(
+      [&](const auto& params) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(params)>,
+                                      CustomInteraction>) {
+          applyBuiltin(params, first, second, &first);
+        }
+      },
+      _kernel);
+}
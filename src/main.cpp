@@ -42,13 +42,10 @@ int main(int argc, char** argv) {
 
   // Adds interaction of particles in universe
   universeGrid.addInteraction(
-      [epsilon, sigma](const Particle& source, Particle& target) {
-        lennardJonesInteraction(source, target, epsilon, sigma);
-      });
+      makeLennardJonesInteraction(epsilon, sigma, r_cut));
 
   // Adds gravitation force
-  universeGrid.addExternalForce(
-      [G](Particle& target) { gravitationalForce(target, G); });
+  universeGrid.addExternalForce(makeGravitationalForce(G));
 
   size_t blue_width = 160;
   size_t blue_height = 40;
@@ -66,7 +63,7 @@ int main(int argc, char** argv) {
   // }
 
   // Adds red rectangle particles
-  bottomLeftCorner = {100, 60};
+  Vector bottomLeftCorner({100, 60});
   for (size_t i = 0; i < red_width; i++) {
     for (size_t j = 0; j < red_height; j++) {
       Vector position = bottomLeftCorner;
@@ -77,6 +74,12 @@ int main(int argc, char** argv) {
 
   universeGrid.setOOBBehavior(ABSORPTION);
 
+  // One thread per core for the interactions
+  universeGrid.setNbThreads(0);
+
+  // Only the 200 frames of the video are written
+  universeGrid.setOutputSchedule(makeFrameCountSchedule(200));
+
   // Simulates evolution
   double timeStep = 0.001;  // 0.00005;
   double finalTime = 19.5;
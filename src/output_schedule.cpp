@@ -0,0 +1,73 @@
+#include "output_schedule.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+/* ------------------------------- public ------------------------------- */
+
+OutputSchedule::OutputSchedule(Kind kind, size_t count,
+                               const std::vector<double>& times)
+    : _kind(kind), _count(count), _times(times) {
+  if (kind != TIMES && count == 0) {
+    throw std::invalid_argument(
+        "An output stride or number of frames must be at least 1.");
+  }
+  std::sort(_times.begin(), _times.end());
+}
+
+void OutputSchedule::start(double timeStep, double finalTime) {
+  _timeStep = timeStep;
+  _nextFrame = 0;
+
+  // Same accumulation of the time as the simulation
+  _nbSteps = 0;
+  for (double time = 0; time < finalTime; time += timeStep) _nbSteps++;
+
+  // A step is written once, even if more frames were asked
+  _nbFrames = std::min(_count, _nbSteps);
+}
+
+bool OutputSchedule::isOutputStep(size_t step, double time) {
+  switch (_kind) {
+    case STRIDE:
+      return step % _count == 0;
+
+    case FRAME_COUNT: {
+      // Frame k is written at step k * nbSteps / nbFrames
+      if (_nextFrame < _nbFrames &&
+          _nextFrame * _nbSteps / _nbFrames <= step) {
+        _nextFrame++;
+        return true;
+      }
+      return false;
+    }
+
+    case TIMES: {
+      // Times closer to this step than to the next one
+      bool output = false;
+      while (_nextFrame < _times.size() &&
+             _times[_nextFrame] < time + _timeStep / 2) {
+        output = true;
+        _nextFrame++;
+      }
+      return output;
+    }
+  }
+  return false;
+}
+
+OutputSchedule makeEveryStepSchedule() {
+  return OutputSchedule(OutputSchedule::STRIDE, 1);
+}
+
+OutputSchedule makeStrideSchedule(size_t stride) {
+  return OutputSchedule(OutputSchedule::STRIDE, stride);
+}
+
+OutputSchedule makeFrameCountSchedule(size_t nbFrames) {
+  return OutputSchedule(OutputSchedule::FRAME_COUNT, nbFrames);
+}
+
+OutputSchedule makeTimesSchedule(const std::vector<double>& times) {
+  return OutputSchedule(OutputSchedule::TIMES, 0, times);
+}
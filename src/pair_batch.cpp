@@ -0,0 +1,121 @@
+#include "pair_batch.hpp"
+
+#include <dimension_kernels.hpp>
+#include <particle.hpp>
+#include <type_traits>
+#include <variant>
+#include <xassert.hpp>
+
+/* ------------------------------- private ------------------------------- */
+
+template <size_t D>
+void PairBatch::applyForcesKernel(ParticleStore& particles, size_t target,
+                                  ParticleStore& sources,
+                                  const std::vector<Interaction>& interactions,
+                                  bool reaction, std::vector<Vector>& forces) {
+  size_t nbPairs = _sources.size();
+  _deltas.resize(nbPairs);
+  _squaredDistances.resize(nbPairs);
+  _factors.assign(nbPairs, 0);
+
+  // Gathers the squared distances
+  const Vector& targetPosition = particles.getPositions()[target];
+  const std::vector<Vector>& sourcePositions = sources.getPositions();
+  for (size_t k = 0; k < nbPairs; k++) {
+    const Vector& sourcePosition = sourcePositions[_sources[k]];
+    double squaredDistance = 0;
+    for (size_t i = 0; i < D; i++) {
+      double delta = sourcePosition[i] - targetPosition[i];
+      _deltas[k][i] = delta;
+      squaredDistance += delta * delta;
+    }
+    _squaredDistances[k] = squaredDistance;
+  }
+
+  // Built-in interactions add their factor for every pair,
+  // the kind of each interaction is visited once for the batch
+  bool hasCustom = false;
+  bool hasMassProducts = false;
+  for (const Interaction& interaction : interactions) {
+    std::visit(
+        [&](const auto& kernel) {
+          using Kernel = std::decay_t<decltype(kernel)>;
+          if constexpr (std::is_same_v<Kernel, LennardJonesParameters>) {
+            _kernels.lennardJones(_squaredDistances.data(), _factors.data(),
+                                  nbPairs, kernel);
+          } else if constexpr (std::is_same_v<Kernel,
+                                              GravitationalParameters>) {
+            if (!hasMassProducts) {
+              const std::vector<double>& sourceMasses = sources.getMasses();
+              double targetMass = particles.getMasses()[target];
+              _massProducts.resize(nbPairs);
+              for (size_t k = 0; k < nbPairs; k++) {
+                _massProducts[k] = targetMass * sourceMasses[_sources[k]];
+              }
+              hasMassProducts = true;
+            }
+            _kernels.gravitational(_squaredDistances.data(),
+                                   _massProducts.data(), _factors.data(),
+                                   nbPairs, kernel);
+          } else {
+            hasCustom = true;
+          }
+        },
+        interaction.getKernel());
+  }
+
+  // Scatters the forces
+  double targetForce[D] = {};
+  for (size_t k = 0; k < nbPairs; k++) {
+    double factor = _factors[k];
+    for (size_t i = 0; i < D; i++) {
+      targetForce[i] += _deltas[k][i] * factor;
+    }
+    if (reaction) {
+      Vector& sourceForce = forces[_sources[k]];
+      for (size_t i = 0; i < D; i++) {
+        sourceForce[i] -= _deltas[k][i] * factor;
+      }
+    }
+  }
+  Vector& force = forces[target];
+  for (size_t i = 0; i < D; i++) {
+    force[i] += targetForce[i];
+  }
+
+  if (!hasCustom) return;
+
+  // Other interactions, pair by pair
+  Particle targetParticle(particles, target);
+  for (const Interaction& interaction : interactions) {
+    if (interaction.isBuiltin()) continue;
+    for (size_t s : _sources) {
+      Particle source(sources, s);
+      if (reaction) {
+        interaction.applyOnPair(source, targetParticle);
+      } else {
+        interaction(source, targetParticle);
+      }
+    }
+  }
+}
+
+/* ------------------------------- public ------------------------------- */
+
+void PairBatch::applyForces(ParticleStore& particles, size_t target,
+                            ParticleStore& sources,
+                            const std::vector<Interaction>& interactions,
+                            bool reaction, std::vector<Vector>& forces) {
+  xassert(particles.getDimension() == sources.getDimension(),
+          "Particles and sources must have the same dimension.");
+  xassert(!reaction || &sources == &particles,
+          "Reaction forces are only applied on the particles.");
+  xassert(forces.size() >= particles.size(),
+          "Forces buffer must have a force for each particle.");
+  if (_sources.empty()) return;
+
+  dispatchDimension(particles.getDimension(), [&](auto d) {
+    applyForcesKernel<decltype(d)::value>(particles, target, sources,
+                                          interactions, reaction, forces);
+  });
+}
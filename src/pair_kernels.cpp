@@ -0,0 +1,256 @@
+#include "pair_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define X86_SIMD
+#include <immintrin.h>
+#endif
+
+/* ------------------------------- intern ------------------------------- */
+
+/* Scalar versions, also used for the last pairs of a batch */
+
+static void lennardJonesScalar(const double* squaredDistances, double* factors,
+                               size_t nbPairs,
+                               const LennardJonesParameters& params) {
+  for (size_t i = 0; i < nbPairs; i++) {
+    factors[i] += lennardJonesFactor(squaredDistances[i], params);
+  }
+}
+
+static void gravitationalScalar(const double* squaredDistances,
+                                const double* massProducts, double* factors,
+                                size_t nbPairs,
+                                const GravitationalParameters& params) {
+  for (size_t i = 0; i < nbPairs; i++) {
+    factors[i] +=
+        gravitationalFactor(squaredDistances[i], massProducts[i], params);
+  }
+}
+
+#ifdef X86_SIMD
+
+/* SSE2: 2 pairs at once (always available on x86-64) */
+
+static void lennardJonesSse2(const double* squaredDistances, double* factors,
+                             size_t nbPairs,
+                             const LennardJonesParameters& params) {
+  const __m128d one = _mm_set1_pd(1);
+  const __m128d two = _mm_set1_pd(2);
+  const __m128d epsilon24 = _mm_set1_pd(24 * params.epsilon);
+  const __m128d sigma6 = _mm_set1_pd(params.sigma6);
+  const __m128d shift = _mm_set1_pd(params.forceShift);
+  const __m128d cutoff = _mm_set1_pd(params.squaredCutoff);
+
+  size_t i = 0;
+  for (; i + 2 <= nbPairs; i += 2) {
+    __m128d r2 = _mm_loadu_pd(squaredDistances + i);
+    __m128d inv2 = _mm_div_pd(one, r2);
+    __m128d s6 = _mm_mul_pd(sigma6, _mm_mul_pd(inv2, _mm_mul_pd(inv2, inv2)));
+    __m128d repulsion = _mm_sub_pd(one, _mm_mul_pd(two, s6));
+    __m128d factor = _mm_mul_pd(_mm_mul_pd(epsilon24, inv2),
+                                _mm_mul_pd(s6, repulsion));
+    if (params.forceShift != 0) {
+      factor = _mm_sub_pd(factor, _mm_mul_pd(shift, _mm_sqrt_pd(inv2)));
+    }
+    factor = _mm_and_pd(factor, _mm_cmplt_pd(r2, cutoff));
+    _mm_storeu_pd(factors + i, _mm_add_pd(_mm_loadu_pd(factors + i), factor));
+  }
+  lennardJonesScalar(squaredDistances + i, factors + i, nbPairs - i, params);
+}
+
+static void gravitationalSse2(const double* squaredDistances,
+                              const double* massProducts, double* factors,
+                              size_t nbPairs,
+                              const GravitationalParameters& params) {
+  if (params.splitScale != 0) {
+    gravitationalScalar(squaredDistances, massProducts, factors, nbPairs,
+                        params);
+    return;
+  }
+  const __m128d one = _mm_set1_pd(1);
+  const __m128d cutoff = _mm_set1_pd(params.squaredCutoff);
+
+  size_t i = 0;
+  for (; i + 2 <= nbPairs; i += 2) {
+    __m128d r2 = _mm_loadu_pd(squaredDistances + i);
+    __m128d inv2 = _mm_div_pd(one, r2);
+    __m128d factor = _mm_mul_pd(_mm_loadu_pd(massProducts + i),
+                                _mm_mul_pd(inv2, _mm_sqrt_pd(inv2)));
+    factor = _mm_and_pd(factor, _mm_cmplt_pd(r2, cutoff));
+    _mm_storeu_pd(factors + i, _mm_add_pd(_mm_loadu_pd(factors + i), factor));
+  }
+  gravitationalScalar(squaredDistances + i, massProducts + i, factors + i,
+                      nbPairs - i, params);
+}
+
+/* AVX2 + FMA: 4 pairs at once */
+
+__attribute__((target("avx2,fma"))) static void lennardJonesAvx2(
+    const double* squaredDistances, double* factors, size_t nbPairs,
+    const LennardJonesParameters& params) {
+  const __m256d one = _mm256_set1_pd(1);
+  const __m256d two = _mm256_set1_pd(2);
+  const __m256d epsilon24 = _mm256_set1_pd(24 * params.epsilon);
+  const __m256d sigma6 = _mm256_set1_pd(params.sigma6);
+  const __m256d shift = _mm256_set1_pd(params.forceShift);
+  const __m256d cutoff = _mm256_set1_pd(params.squaredCutoff);
+
+  size_t i = 0;
+  for (; i + 4 <= nbPairs; i += 4) {
+    __m256d r2 = _mm256_loadu_pd(squaredDistances + i);
+    __m256d inv2 = _mm256_div_pd(one, r2);
+    __m256d s6 =
+        _mm256_mul_pd(sigma6, _mm256_mul_pd(inv2, _mm256_mul_pd(inv2, inv2)));
+    __m256d repulsion = _mm256_fnmadd_pd(two, s6, one);
+    __m256d factor = _mm256_mul_pd(_mm256_mul_pd(epsilon24, inv2),
+                                   _mm256_mul_pd(s6, repulsion));
+    if (params.forceShift != 0) {
+      factor = _mm256_fnmadd_pd(shift, _mm256_sqrt_pd(inv2), factor);
+    }
+    factor = _mm256_and_pd(factor, _mm256_cmp_pd(r2, cutoff, _CMP_LT_OQ));
+    _mm256_storeu_pd(factors + i,
+                     _mm256_add_pd(_mm256_loadu_pd(factors + i), factor));
+  }
+  lennardJonesScalar(squaredDistances + i, factors + i, nbPairs - i, params);
+}
+
+__attribute__((target("avx2,fma"))) static void gravitationalAvx2(
+    const double* squaredDistances, const double* massProducts,
+    double* factors, size_t nbPairs, const GravitationalParameters& params) {
+  if (params.splitScale != 0) {
+    gravitationalScalar(squaredDistances, massProducts, factors, nbPairs,
+                        params);
+    return;
+  }
+  const __m256d one = _mm256_set1_pd(1);
+  const __m256d cutoff = _mm256_set1_pd(params.squaredCutoff);
+
+  size_t i = 0;
+  for (; i + 4 <= nbPairs; i += 4) {
+    __m256d r2 = _mm256_loadu_pd(squaredDistances + i);
+    __m256d inv2 = _mm256_div_pd(one, r2);
+    __m256d factor = _mm256_mul_pd(_mm256_loadu_pd(massProducts + i),
+                                   _mm256_mul_pd(inv2, _mm256_sqrt_pd(inv2)));
+    factor = _mm256_and_pd(factor, _mm256_cmp_pd(r2, cutoff, _CMP_LT_OQ));
+    _mm256_storeu_pd(factors + i,
+                     _mm256_add_pd(_mm256_loadu_pd(factors + i), factor));
+  }
+  gravitationalScalar(squaredDistances + i, massProducts + i, factors + i,
+                      nbPairs - i, params);
+}
+
+/* AVX-512: 8 pairs at once, the last ones with a mask */
+
+__attribute__((target("avx512f"))) static void lennardJonesAvx512(
+    const double* squaredDistances, double* factors, size_t nbPairs,
+    const LennardJonesParameters& params) {
+  const __m512d one = _mm512_set1_pd(1);
+  const __m512d two = _mm512_set1_pd(2);
+  const __m512d epsilon24 = _mm512_set1_pd(24 * params.epsilon);
+  const __m512d sigma6 = _mm512_set1_pd(params.sigma6);
+  const __m512d shift = _mm512_set1_pd(params.forceShift);
+  const __m512d cutoff = _mm512_set1_pd(params.squaredCutoff);
+
+  for (size_t i = 0; i < nbPairs; i += 8) {
+    __mmask8 lanes = nbPairs - i >= 8 ? 0xFF : (1u << (nbPairs - i)) - 1;
+    // Unused lanes get r² = 1 to avoid dividing by 0
+    __m512d r2 = _mm512_mask_loadu_pd(one, lanes, squaredDistances + i);
+    __m512d inv2 = _mm512_div_pd(one, r2);
+    __m512d s6 =
+        _mm512_mul_pd(sigma6, _mm512_mul_pd(inv2, _mm512_mul_pd(inv2, inv2)));
+    __m512d repulsion = _mm512_fnmadd_pd(two, s6, one);
+    __m512d factor = _mm512_mul_pd(_mm512_mul_pd(epsilon24, inv2),
+                                   _mm512_mul_pd(s6, repulsion));
+    if (params.forceShift != 0) {
+      __m512d inv = _mm512_maskz_sqrt_pd(lanes, inv2);
+      factor = _mm512_fnmadd_pd(shift, inv, factor);
+    }
+    __mmask8 inRange = _mm512_mask_cmp_pd_mask(lanes, r2, cutoff, _CMP_LT_OQ);
+    __m512d sum = _mm512_add_pd(_mm512_maskz_loadu_pd(lanes, factors + i),
+                                _mm512_maskz_mov_pd(inRange, factor));
+    _mm512_mask_storeu_pd(factors + i, lanes, sum);
+  }
+}
+
+__attribute__((target("avx512f"))) static void gravitationalAvx512(
+    const double* squaredDistances, const double* massProducts,
+    double* factors, size_t nbPairs, const GravitationalParameters& params) {
+  if (params.splitScale != 0) {
+    gravitationalScalar(squaredDistances, massProducts, factors, nbPairs,
+                        params);
+    return;
+  }
+  const __m512d one = _mm512_set1_pd(1);
+  const __m512d cutoff = _mm512_set1_pd(params.squaredCutoff);
+
+  for (size_t i = 0; i < nbPairs; i += 8) {
+    __mmask8 lanes = nbPairs - i >= 8 ? 0xFF : (1u << (nbPairs - i)) - 1;
+    __m512d r2 = _mm512_mask_loadu_pd(one, lanes, squaredDistances + i);
+    __m512d inv2 = _mm512_div_pd(one, r2);
+    __m512d massProduct = _mm512_maskz_loadu_pd(lanes, massProducts + i);
+    __m512d inv3 = _mm512_mul_pd(inv2, _mm512_maskz_sqrt_pd(lanes, inv2));
+    __m512d factor = _mm512_mul_pd(massProduct, inv3);
+    __mmask8 inRange = _mm512_mask_cmp_pd_mask(lanes, r2, cutoff, _CMP_LT_OQ);
+    __m512d sum = _mm512_add_pd(_mm512_maskz_loadu_pd(lanes, factors + i),
+                                _mm512_maskz_mov_pd(inRange, factor));
+    _mm512_mask_storeu_pd(factors + i, lanes, sum);
+  }
+}
+
+#endif  // X86_SIMD
+
+static const PairKernels scalarKernels = {SimdLevel::SCALAR, "scalar",
+                                          lennardJonesScalar,
+                                          gravitationalScalar};
+
+#ifdef X86_SIMD
+static const PairKernels sse2Kernels = {SimdLevel::SSE2, "SSE2",
+                                        lennardJonesSse2, gravitationalSse2};
+
+static const PairKernels avx2Kernels = {SimdLevel::AVX2, "AVX2",
+                                        lennardJonesAvx2, gravitationalAvx2};
+
+static const PairKernels avx512Kernels = {
+    SimdLevel::AVX512, "AVX-512", lennardJonesAvx512, gravitationalAvx512};
+#endif
+
+/* ------------------------------- public ------------------------------- */
+
+SimdLevel detectSimdLevel() {
+#ifdef X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SimdLevel::AVX2;
+  }
+  return SimdLevel::SSE2;
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+
+const PairKernels& getPairKernels(SimdLevel level) {
+  static const SimdLevel supported = detectSimdLevel();
+  level = std::min(level, supported);
+
+  switch (level) {
+#ifdef X86_SIMD
+    case SimdLevel::AVX512:
+      return avx512Kernels;
+    case SimdLevel::AVX2:
+      return avx2Kernels;
+    case SimdLevel::SSE2:
+      return sse2Kernels;
+#endif
+    default:
+      return scalarKernels;
+  }
+}
+
+const PairKernels& getPairKernels() {
+  static const PairKernels& best = getPairKernels(detectSimdLevel());
+  return best;
+}
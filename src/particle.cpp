@@ -11,48 +11,37 @@
 
 /* ------------------------------- public ------------------------------- */
 
-// Initialize static variable outside the class
-int Particle::_particleCount = 0;
-
 Particle::Particle(Vector pos, Vector speed, double mass, std::string name) {
   xassert(pos.getDimension() == speed.getDimension(),
           "Position and speed dimensions must match.");
 
-  _dimension = pos.getDimension();
-  _position = pos;
-  _speed = speed;
-  _force = Vector(_dimension);
-  _oldForce = Vector(_dimension);
-  _mass = mass;
-  _name = name;
-  _id = _particleCount;
-  _particleCount++;  // Incrémente le compteur à chaque création d'instance
+  _ownStore = std::make_shared<ParticleStore>(pos.getDimension());
+  _store = _ownStore.get();
+  _index = _store->add(pos, speed, mass, name);
 }
 
 std::ostream& operator<<(std::ostream& strm, const Particle& p) {
-  return strm << "Particle " << p._id << std::endl
-              << "    name = " << p._name << std::endl
-              << "    mass = " << p._mass << std::endl
-              << "    position = " << p._position << std::endl
-              << "    speed    = " << p._speed << std::endl
-              << "    force = " << p._force;
+  return strm << "Particle " << p._store->getIds()[p._index] << std::endl
+              << "    name = " << p.getName() << std::endl
+              << "    mass = " << p.getMass() << std::endl
+              << "    position = " << p.getPosition() << std::endl
+              << "    speed    = " << p.getSpeed() << std::endl
+              << "    force = " << p.getForce();
 }
 
 double Particle::distanceTo(const Particle& other) const {
-  Vector diff = other._position;
-  diff -= _position;
-  return diff.norm();
+  return norm(other.getPosition() - getPosition());
 }
 
-void Particle::applyExternalForces(const std::list<ExternalForce>& extForces) {
+void Particle::applyExternalForces(const std::vector<ExternalForce>& extForces) {
   for (const ExternalForce& force : extForces) {
     force.applyOn(*this);
   }
 }
 
 void Particle::applyInteractionForcesOn(
-    Particle& other, const std::list<Interaction>& interactions) const {
-  xassert(this != &other,
+    Particle& other, const std::vector<Interaction>& interactions) const {
+  xassert(!isSameParticle(other),
           "Force calculation must be applied on two different particles.");
 
   for (const Interaction& interaction : interactions) {
@@ -60,41 +49,52 @@ void Particle::applyInteractionForcesOn(
   }
 }
 
+void Particle::applyInteractionForcesWith(
+    Particle& other, const std::vector<Interaction>& interactions) {
+  xassert(!isSameParticle(other),
+          "Force calculation must be applied on two different particles.");
+
+  for (const Interaction& interaction : interactions) {
+    interaction.applyOnPair(*this, other);
+  }
+}
+
 void Particle::invertSpeed(size_t i) {
-  xassert(i < _dimension, "i coordinate do not exist for this particle.");
-  _speed[i] *= -1;
+  xassert(i < getDimension(), "i coordinate do not exist for this particle.");
+  _store->getSpeeds()[_index][i] *= -1;
 }
 
 void Particle::setPosCoord(size_t coord, double value) {
-  xassert(coord < _dimension, "coord is too high.");
-  _position[coord] = value;
+  xassert(coord < getDimension(), "coord is too high.");
+  _store->getPositions()[_index][coord] = value;
 }
 
 void Particle::addToForceCoord(size_t coord, double value) {
-  xassert(coord < _dimension, "coord is too high.");
-  _force[coord] += value;
+  xassert(coord < getDimension(), "coord is too high.");
+  _store->getForces()[_index][coord] += value;
 }
 
 void Particle::addToForce(const Vector& vect) {
-  xassert(vect.getDimension() == _dimension,
+  xassert(vect.getDimension() == getDimension(),
           "Vector and particle dimension must match.");
-  _force += vect;
+  _store->getForces()[_index] += vect;
 }
 
 void Particle::addToPosition(const Vector& vect) {
-  xassert(vect.getDimension() == _dimension,
+  xassert(vect.getDimension() == getDimension(),
           "Vector and particle dimension must match.");
-  _position += vect;
+  _store->getPositions()[_index] += vect;
 }
 
 void Particle::addToSpeed(const Vector& vect) {
-  xassert(vect.getDimension() == _dimension,
+  xassert(vect.getDimension() == getDimension(),
           "Vector and particle dimension must match.");
-  _speed += vect;
+  _store->getSpeeds()[_index] += vect;
 }
 
 void Particle::setForceToZero() {
-  for (size_t i = 0; i < _dimension; i++) {
-    _force[i] = 0;
+  Vector& force = _store->getForces()[_index];
+  for (size_t i = 0; i < getDimension(); i++) {
+    force[i] = 0;
   }
-}
\ No newline at end of file
+}
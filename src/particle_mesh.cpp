@@ -0,0 +1,218 @@
+#include "particle_mesh.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <xassert.hpp>
+
+/* ------------------------------- intern ------------------------------- */
+
+static const double pi = std::acos(-1.0);
+
+/* Mesh spacing is at most the split scale over this ratio */
+static const double splitScaleOverSpacing = 1.25;
+
+/**
+ * @brief Number of mesh points in each dimension: the smallest
+ *        power of 2 giving the spacing wanted
+ * @param lowerBound
+ * @param upperBound
+ * @param splitScale
+ * @return std::vector<size_t>
+ */
+static std::vector<size_t> meshDimensions(const Vector& lowerBound,
+                                          const Vector& upperBound,
+                                          double splitScale) {
+  if (lowerBound.getDimension() != 3) {
+    throw std::invalid_argument("Particle mesh needs dimension 3.");
+  }
+  if (splitScale <= 0) {
+    throw std::invalid_argument("Split scale must be positive.");
+  }
+
+  double maxSpacing = splitScale / splitScaleOverSpacing;
+  std::vector<size_t> dimensions;
+  for (size_t d = 0; d < 3; d++) {
+    double side = upperBound[d] - lowerBound[d];
+    xassert(side > 0, "Upper bound must have greater coordinates.");
+    size_t nbPoints = 1;
+    while (side / nbPoints > maxSpacing) nbPoints <<= 1;
+    dimensions.push_back(std::max<size_t>(nbPoints, 2));
+  }
+  return dimensions;
+}
+
+/**
+ * @brief Runs body(first, last) on blocks of [0, n),
+ *        on the threads of pool if any
+ */
+template <class Body>
+static void runBlocks(ThreadPool* pool, size_t n, const Body& body) {
+  if (!pool) {
+    body(0, n);
+    return;
+  }
+  size_t nbThreads = pool->getNbThreads();
+  pool->parallelFor(n, (n + nbThreads - 1) / nbThreads,
+                    [&](size_t first, size_t last, size_t) {
+                      body(first, last);
+                    });
+}
+
+/**
+ * @brief sin(x) / x
+ * @param x
+ * @return double
+ */
+static double sinc(double x) { return x == 0 ? 1 : std::sin(x) / x; }
+
+/* ------------------------------- private ------------------------------- */
+
+void ParticleMesh::cloudInCell(const Vector& position, size_t indices[3][2],
+                               double weights[3][2]) const {
+  for (size_t d = 0; d < 3; d++) {
+    double u = (position[d] - _lowerBound[d]) / _spacings[d];
+    double below = std::floor(u);
+    double fraction = u - below;
+    long n = _nbPoints[d];
+    long index = static_cast<long>(below) % n;
+    if (index < 0) index += n;
+    indices[d][0] = index;
+    indices[d][1] = (index + 1) % n;
+    weights[d][0] = 1 - fraction;
+    weights[d][1] = fraction;
+  }
+}
+
+void ParticleMesh::assignMasses(const ParticleStore& particles) {
+  const std::vector<Vector>& positions = particles.getPositions();
+  const std::vector<double>& masses = particles.getMasses();
+  double cellVolume = _spacings[0] * _spacings[1] * _spacings[2];
+
+  std::fill(_density.begin(), _density.end(), 0.0);
+  size_t indices[3][2];
+  double weights[3][2];
+  for (size_t i = 0; i < particles.size(); i++) {
+    cloudInCell(positions[i], indices, weights);
+    double density = masses[i] / cellVolume;
+    for (size_t c = 0; c < 8; c++) {
+      size_t a = c & 1, b = (c >> 1) & 1, e = (c >> 2) & 1;
+      size_t point =
+          indices[0][a] +
+          _nbPoints[0] * (indices[1][b] + _nbPoints[1] * indices[2][e]);
+      _density[point] +=
+          density * weights[0][a] * weights[1][b] * weights[2][e];
+    }
+  }
+}
+
+void ParticleMesh::computeAccelerations(ThreadPool* pool) {
+  _fft.transform(_density, false, pool);
+
+  // a(k) = -i k φ(k), transformed back for each dimension
+  size_t size = _fft.getSize();
+  size_t stride = 1;
+  for (size_t d = 0; d < 3; d++) {
+    const std::vector<double>& waveNumbers = _waveNumbers[d];
+    runBlocks(pool, size, [&](size_t first, size_t last) {
+      for (size_t p = first; p < last; p++) {
+        double k = waveNumbers[(p / stride) % _nbPoints[d]];
+        std::complex<double> potential = _greenFunction[p] * _density[p];
+        _field[p] = std::complex<double>(k * potential.imag(),
+                                         -k * potential.real());
+      }
+    });
+    _fft.transform(_field, true, pool);
+    std::vector<double>& accelerations = _accelerations[d];
+    runBlocks(pool, size, [&](size_t first, size_t last) {
+      for (size_t p = first; p < last; p++) accelerations[p] = _field[p].real();
+    });
+    stride *= _nbPoints[d];
+  }
+}
+
+/* ------------------------------- public ------------------------------- */
+
+ParticleMesh::ParticleMesh(const Vector& lowerBound, const Vector& upperBound,
+                           double splitScale)
+    : _lowerBound(lowerBound),
+      _splitScale(splitScale),
+      _fft(meshDimensions(lowerBound, upperBound, splitScale)) {
+  size_t size = _fft.getSize();
+  _density.resize(size);
+  _field.resize(size);
+  _greenFunction.resize(size);
+
+  double sides[3];
+  std::vector<double> fullWaveNumbers[3];
+  for (size_t d = 0; d < 3; d++) {
+    size_t n = _fft.getDimensions()[d];
+    _nbPoints[d] = n;
+    sides[d] = upperBound[d] - lowerBound[d];
+    _spacings[d] = sides[d] / n;
+    _accelerations[d].resize(size);
+    fullWaveNumbers[d].resize(n);
+    _waveNumbers[d].resize(n);
+    for (size_t i = 0; i < n; i++) {
+      double m = i < n / 2 ? double(i) : double(i) - double(n);
+      fullWaveNumbers[d][i] = 2 * pi * m / sides[d];
+      _waveNumbers[d][i] = i == n / 2 ? 0 : fullWaveNumbers[d][i];
+    }
+  }
+
+  // φ(k) = -4π ρ(k) exp(-k² rs²) / k², divided by the square of the
+  // cloud in cell window Π sinc²(k h / 2) and by the number of points
+  // (normalization of the inverse transform). The mean density has
+  // no potential (k = 0).
+  for (size_t p = 0; p < size; p++) {
+    size_t i[3] = {p % _nbPoints[0], (p / _nbPoints[0]) % _nbPoints[1],
+                   p / (_nbPoints[0] * _nbPoints[1])};
+    double squaredWaveNumber = 0;
+    double window = 1;
+    for (size_t d = 0; d < 3; d++) {
+      double k = fullWaveNumbers[d][i[d]];
+      squaredWaveNumber += k * k;
+      double s = sinc(k * _spacings[d] / 2);
+      window *= s * s;
+    }
+    if (squaredWaveNumber == 0) {
+      _greenFunction[p] = 0;
+      continue;
+    }
+    _greenFunction[p] = -4 * pi *
+                        std::exp(-squaredWaveNumber * splitScale * splitScale) /
+                        (squaredWaveNumber * window * window * size);
+  }
+}
+
+void ParticleMesh::applyForces(ParticleStore& particles, ThreadPool* pool) {
+  xassert(particles.getDimension() == 3,
+          "Particles must have the dimension of the mesh.");
+  assignMasses(particles);
+  computeAccelerations(pool);
+
+  // Interpolation with the weights of the assignment
+  const std::vector<Vector>& positions = particles.getPositions();
+  const std::vector<double>& masses = particles.getMasses();
+  std::vector<Vector>& forces = particles.getForces();
+  runBlocks(pool, particles.size(), [&](size_t first, size_t last) {
+    size_t indices[3][2];
+    double weights[3][2];
+    for (size_t i = first; i < last; i++) {
+      cloudInCell(positions[i], indices, weights);
+      double acceleration[3] = {0, 0, 0};
+      for (size_t c = 0; c < 8; c++) {
+        size_t a = c & 1, b = (c >> 1) & 1, e = (c >> 2) & 1;
+        size_t point =
+            indices[0][a] +
+            _nbPoints[0] * (indices[1][b] + _nbPoints[1] * indices[2][e]);
+        double weight = weights[0][a] * weights[1][b] * weights[2][e];
+        for (size_t d = 0; d < 3; d++) {
+          acceleration[d] += weight * _accelerations[d][point];
+        }
+      }
+      for (size_t d = 0; d < 3; d++) {
+        forces[i][d] += masses[i] * acceleration[d];
+      }
+    }
+  });
+}
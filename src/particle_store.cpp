@@ -0,0 +1,140 @@
+#include <particle.hpp>
+#include <particle_store.hpp>
+#include <xassert.hpp>
+
+/* ------------------------------- private ------------------------------- */
+
+// Initialize static variable outside the class
+int ParticleStore::_particleCount = 0;
+
+/* ------------------------------- public ------------------------------- */
+
+size_t ParticleStore::add(const Vector& pos, const Vector& speed, double mass,
+                          const std::string& name) {
+  xassert(pos.getDimension() == _dimension &&
+              speed.getDimension() == _dimension,
+          "Position and speed dimensions must match with store dimension.");
+
+  _positions.push_back(pos);
+  _speeds.push_back(speed);
+  _forces.emplace_back(_dimension);
+  _masses.push_back(mass);
+  for (std::vector<Vector>& forces : _levelForces) {
+    forces.emplace_back(_dimension);
+  }
+  _names.push_back(name);
+  _ids.push_back(_particleCount);
+  _particleCount++;  // Incrémente le compteur à chaque création de particule
+
+  return _masses.size() - 1;
+}
+
+size_t ParticleStore::addWithId(const Vector& pos, const Vector& speed,
+                                double mass, const std::string& name, int id) {
+  xassert(pos.getDimension() == _dimension &&
+              speed.getDimension() == _dimension,
+          "Position and speed dimensions must match with store dimension.");
+
+  _positions.push_back(pos);
+  _speeds.push_back(speed);
+  _forces.emplace_back(_dimension);
+  _masses.push_back(mass);
+  for (std::vector<Vector>& forces : _levelForces) {
+    forces.emplace_back(_dimension);
+  }
+  _names.push_back(name);
+  _ids.push_back(id);
+
+  return _masses.size() - 1;
+}
+
+size_t ParticleStore::addCopy(const ParticleStore& source, size_t index) {
+  xassert(source._dimension == _dimension, "Stores dimensions must match.");
+  xassert(index < source.size(), "Particle index out of bounds.");
+
+  _positions.push_back(source._positions[index]);
+  _speeds.push_back(source._speeds[index]);
+  _forces.push_back(source._forces[index]);
+  _masses.push_back(source._masses[index]);
+  for (size_t level = 0; level < _levelForces.size(); level++) {
+    _levelForces[level].push_back(level < source._levelForces.size()
+                                      ? source._levelForces[level][index]
+                                      : Vector(_dimension));
+  }
+  _names.push_back(source._names[index]);
+  _ids.push_back(source._ids[index]);
+
+  return _masses.size() - 1;
+}
+
+void ParticleStore::setCopy(const ParticleStore& source, size_t index,
+                            size_t destination) {
+  xassert(source._dimension == _dimension, "Stores dimensions must match.");
+  xassert(index < source.size() && destination < size(),
+          "Particle index out of bounds.");
+
+  _positions[destination] = source._positions[index];
+  _speeds[destination] = source._speeds[index];
+  _forces[destination] = source._forces[index];
+  _masses[destination] = source._masses[index];
+  for (size_t level = 0; level < _levelForces.size(); level++) {
+    _levelForces[level][destination] =
+        level < source._levelForces.size() ? source._levelForces[level][index]
+                                           : Vector(_dimension);
+  }
+  _names[destination] = source._names[index];
+  _ids[destination] = source._ids[index];
+}
+
+void ParticleStore::copyOutputColumns(const ParticleStore& source) {
+  _dimension = source._dimension;
+  _positions = source._positions;
+  _speeds = source._speeds;
+  _forces = source._forces;
+  _masses = source._masses;
+  _levelForces.clear();
+  _names.resize(source.size());
+  _ids = source._ids;
+}
+
+void ParticleStore::resize(size_t n) {
+  _positions.resize(n, Vector(_dimension));
+  _speeds.resize(n, Vector(_dimension));
+  _forces.resize(n, Vector(_dimension));
+  _masses.resize(n, 0);
+  for (std::vector<Vector>& forces : _levelForces) {
+    forces.resize(n, Vector(_dimension));
+  }
+  _names.resize(n);
+  _ids.resize(n, -1);
+}
+
+void ParticleStore::reserve(size_t n) {
+  _positions.reserve(n);
+  _speeds.reserve(n);
+  _forces.reserve(n);
+  _masses.reserve(n);
+  for (std::vector<Vector>& forces : _levelForces) forces.reserve(n);
+  _names.reserve(n);
+  _ids.reserve(n);
+}
+
+void ParticleStore::clear() {
+  _positions.clear();
+  _speeds.clear();
+  _forces.clear();
+  _masses.clear();
+  for (std::vector<Vector>& forces : _levelForces) forces.clear();
+  _names.clear();
+  _ids.clear();
+}
+
+void ParticleStore::setNbForceLevels(size_t nbLevels) {
+  _levelForces.assign(nbLevels,
+                      std::vector<Vector>(size(), Vector(_dimension)));
+}
+
+Particle ParticleStore::at(size_t i) {
+  xassert(i < size(), "Particle index out of bounds.");
+  return Particle(*this, i);
+}
@@ -0,0 +1,119 @@
+#include "thread_pool.hpp"
+
+/* ------------------------------- private ------------------------------- */
+
+void ThreadPool::workerLoop(size_t thread) {
+  size_t lastJob = 0;
+  while (true) {
+    const std::function<void(size_t)>* job;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _jobReady.wait(lock,
+                     [&] { return _stopping || _jobNumber != lastJob; });
+      if (_stopping) return;
+      lastJob = _jobNumber;
+      job = _job;
+    }
+
+    std::exception_ptr error;
+    try {
+      (*job)(thread);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (error && !_error) _error = error;
+    if (--_nbRunning == 0) _jobDone.notify_one();
+  }
+}
+
+void ThreadPool::dealChunks() {
+  size_t nbChunks = _chunkStarts.size() - 1;
+  size_t nbThreads = getNbThreads();
+  for (size_t thread = 0; thread < nbThreads; thread++) {
+    std::lock_guard<std::mutex> lock(_deques[thread].mutex);
+    _deques[thread].front = thread * nbChunks / nbThreads;
+    _deques[thread].back = (thread + 1) * nbChunks / nbThreads;
+  }
+}
+
+/* ------------------------------- public ------------------------------- */
+
+ThreadPool::ThreadPool(size_t nbThreads) {
+  if (nbThreads == 0) {
+    nbThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  _deques = std::vector<ChunkDeque>(nbThreads);
+  for (size_t thread = 1; thread < nbThreads; thread++) {
+    _workers.emplace_back(&ThreadPool::workerLoop, this, thread);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _jobReady.notify_all();
+  for (std::thread& worker : _workers) worker.join();
+}
+
+void ThreadPool::run(const std::function<void(size_t thread)>& job) {
+  if (_workers.empty()) {
+    job(0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _job = &job;
+    _nbRunning = _workers.size();
+    _error = nullptr;
+    _jobNumber++;
+  }
+  _jobReady.notify_all();
+
+  std::exception_ptr error;
+  try {
+    job(0);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  _jobDone.wait(lock, [&] { return _nbRunning == 0; });
+  if (!error) error = _error;
+  if (error) std::rethrow_exception(error);
+}
+
+bool ThreadPool::takeChunk(size_t thread, size_t& first, size_t& last) {
+  size_t nbThreads = getNbThreads();
+  size_t chunk = 0;
+  bool found = false;
+
+  // Own chunks first, in order
+  {
+    ChunkDeque& deque = _deques[thread];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.front < deque.back) {
+      chunk = deque.front++;
+      found = true;
+    }
+  }
+
+  // Then steals the last chunk of the next threads
+  for (size_t k = 1; !found && k < nbThreads; k++) {
+    ChunkDeque& deque = _deques[(thread + k) % nbThreads];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.front < deque.back) {
+      chunk = --deque.back;
+      found = true;
+    }
+  }
+
+  if (!found) return false;
+  first = _chunkStarts[chunk];
+  last = _chunkStarts[chunk + 1];
+  return true;
+}
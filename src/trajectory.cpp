@@ -0,0 +1,383 @@
+#include "trajectory.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "xassert.hpp"
+
+/* ------------------------------- intern ------------------------------- */
+
+template <typename T>
+static void writeValue(std::ostream& file, T value) {
+  file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static T readValue(std::istream& file) {
+  T value;
+  file.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+/* Number of blocks of a compressed frame */
+static size_t nbBlocks(size_t nbParticles, size_t blockSize) {
+  return (nbParticles + blockSize - 1) / blockSize;
+}
+
+/* ------------------------------- private ------------------------------ */
+
+void TrajectoryWriter::writeHeader(uint64_t indexOffset) {
+  _file.seekp(0);
+  _file.write(MAGIC, sizeof(MAGIC));
+  writeValue<uint32_t>(_file, VERSION);
+  writeValue<uint32_t>(_file, _dimension);
+  writeValue<uint32_t>(_file, _dimension + 1);
+  writeValue<uint64_t>(_file, _index.size());
+  writeValue<uint64_t>(_file, indexOffset);
+
+  // Codec, zeros if frames are not compressed
+  writeValue<uint32_t>(_file, _codec.has_value());
+  writeValue<uint32_t>(_file, _codec ? TrajectoryCodec::BLOCK_SIZE : 0);
+  writeValue<uint64_t>(_file, _codec ? _codec->getKeyInterval() : 0);
+  writeValue<double>(_file, _codec ? _codec->getPositionPrecision() : 0);
+  writeValue<double>(_file, _codec ? _codec->getForcePrecision() : 0);
+  for (size_t d = 0; d < 3; d++) {
+    bool hasOrigin = _codec && d < _codec->getOrigin().getDimension();
+    writeValue<double>(_file, hasOrigin ? _codec->getOrigin()[d] : 0);
+  }
+}
+
+void TrajectoryWriter::writeCompressedFrame(
+    const std::vector<Vector>& positions,
+    const std::vector<double>& forceNorms) {
+  size_t nbParticles = positions.size();
+  size_t nbValues = _dimension + 1;
+
+  // Rounded values, column by column
+  _quantized.resize(nbValues * nbParticles);
+  for (size_t i = 0; i < nbParticles; i++) {
+    for (size_t d = 0; d < _dimension; d++) {
+      _quantized[d * nbParticles + i] =
+          _codec->quantizePosition(positions[i][d], d);
+    }
+    _quantized[_dimension * nbParticles + i] =
+        _codec->quantizeForce(forceNorms[i]);
+  }
+
+  // Differences with the previous frame if it has the same particles
+  bool key = _index.empty() || _previous.size() != _quantized.size() ||
+             _index.size() % _codec->getKeyInterval() == 0;
+
+  size_t blockSize = TrajectoryCodec::BLOCK_SIZE;
+  _blocks.resize(nbBlocks(nbParticles, blockSize));
+  auto compressBlocks = [&](size_t first, size_t last, size_t) {
+    std::vector<int64_t> values;
+    for (size_t b = first; b < last; b++) {
+      size_t begin = b * blockSize;
+      size_t end = std::min(begin + blockSize, nbParticles);
+      values.clear();
+      for (size_t c = 0; c < nbValues; c++) {
+        for (size_t i = begin; i < end; i++) {
+          size_t k = c * nbParticles + i;
+          values.push_back(key ? _quantized[k] : _quantized[k] - _previous[k]);
+        }
+      }
+      _blocks[b].clear();
+      TrajectoryCodec::compressBlock(values.data(), values.size(), _blocks[b]);
+    }
+  };
+  if (_pool) {
+    _pool->parallelFor(_blocks.size(), 1, compressBlocks);
+  } else {
+    compressBlocks(0, _blocks.size(), 0);
+  }
+  _previous.swap(_quantized);
+
+  uint64_t payloadSize = sizeof(uint8_t);
+  for (const std::string& block : _blocks) {
+    payloadSize += sizeof(uint64_t) + block.size();
+  }
+  writeValue<uint64_t>(_file, payloadSize);
+  writeValue<uint8_t>(_file, key);
+  for (const std::string& block : _blocks) {
+    writeValue<uint64_t>(_file, block.size());
+    _file.write(block.data(), block.size());
+  }
+}
+
+void TrajectoryReader::scanFrames(uint64_t fileSize) {
+  uint64_t offset = TrajectoryWriter::HEADER_SIZE;
+  while (offset + TrajectoryWriter::FRAME_HEADER_SIZE <= fileSize) {
+    _file.seekg(offset);
+    uint64_t nbParticles = readValue<uint64_t>(_file);
+    double time = readValue<double>(_file);
+    uint64_t end = offset + TrajectoryWriter::FRAME_HEADER_SIZE;
+    if (_codec) {
+      end += sizeof(uint64_t) + readValue<uint64_t>(_file);
+    } else {
+      end += nbParticles * _nbValues * sizeof(double);
+    }
+    // The last frame may have been cut while it was written
+    if (!_file || end > fileSize) break;
+    _offsets.push_back(offset);
+    _nbParticles.push_back(nbParticles);
+    _times.push_back(time);
+    offset = end;
+  }
+  _file.clear();
+}
+
+bool TrajectoryReader::isKeyFrame(size_t frame) const {
+  _file.seekg(_offsets[frame] + TrajectoryWriter::FRAME_HEADER_SIZE +
+              sizeof(uint64_t));
+  return readValue<uint8_t>(_file) != 0;
+}
+
+void TrajectoryReader::decodeFrame(size_t frame) const {
+  size_t nbParticles = _nbParticles[frame];
+  _decodedFrame = SIZE_MAX;
+  _file.seekg(_offsets[frame] + TrajectoryWriter::FRAME_HEADER_SIZE);
+  uint64_t payloadSize = readValue<uint64_t>(_file);
+  std::string payload(payloadSize, '\0');
+  _file.read(&payload[0], payloadSize);
+  if (!_file) {
+    _file.clear();
+    throw std::runtime_error("Truncated trajectory frame: " + _fileName);
+  }
+
+  bool key = payload[0] != 0;
+  if (key) _decoded.assign(_nbValues * nbParticles, 0);
+  std::vector<int64_t> values;
+  size_t pos = sizeof(uint8_t);
+  for (size_t b = 0; b < nbBlocks(nbParticles, _blockSize); b++) {
+    size_t begin = b * _blockSize;
+    size_t end = std::min(begin + _blockSize, nbParticles);
+    uint64_t blockSize;
+    if (pos + sizeof(blockSize) > payload.size()) {
+      throw std::runtime_error("Corrupted trajectory frame: " + _fileName);
+    }
+    std::memcpy(&blockSize, payload.data() + pos, sizeof(blockSize));
+    pos += sizeof(blockSize);
+    if (blockSize > payload.size() - pos) {
+      throw std::runtime_error("Corrupted trajectory frame: " + _fileName);
+    }
+
+    values.resize(_nbValues * (end - begin));
+    TrajectoryCodec::decompressBlock(payload.data() + pos, blockSize,
+                                     values.data(), values.size());
+    pos += blockSize;
+
+    const int64_t* value = values.data();
+    for (size_t c = 0; c < _nbValues; c++) {
+      for (size_t i = begin; i < end; i++) {
+        _decoded[c * nbParticles + i] += *value++;
+      }
+    }
+  }
+  _decodedFrame = frame;
+}
+
+/* ------------------------------- public ------------------------------- */
+
+TrajectoryWriter::TrajectoryWriter(const std::string& fileName,
+                                   size_t dimension)
+    : _file(fileName, std::ios::binary | std::ios::trunc),
+      _dimension(dimension) {
+  if (!_file) {
+    throw std::runtime_error("Error opening file for writing: " + fileName);
+  }
+  xassert(dimension >= 1 && dimension <= 3, "dimension must be 1, 2 or 3.");
+  writeHeader(0);
+}
+
+TrajectoryWriter::TrajectoryWriter(const std::string& fileName,
+                                   size_t dimension,
+                                   const TrajectoryCodec& codec)
+    : TrajectoryWriter(fileName, dimension) {
+  _codec = codec;
+  if (codec.getNbThreads() != 1) {
+    _pool = std::make_unique<ThreadPool>(codec.getNbThreads());
+  }
+  writeHeader(0);
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+  if (_file.is_open()) close();
+}
+
+void TrajectoryWriter::writeFrame(const ParticleStore& particles,
+                                  double time) {
+  const std::vector<Vector>& forces = particles.getForces();
+  _forceNorms.resize(particles.size());
+  for (size_t i = 0; i < particles.size(); i++) {
+    _forceNorms[i] = forces[i].norm();
+  }
+  writeFrame(particles.getPositions(), _forceNorms, time);
+}
+
+void TrajectoryWriter::writeFrame(const std::vector<Vector>& positions,
+                                  const std::vector<double>& forceNorms,
+                                  double time) {
+  xassert(_file.is_open(), "The trajectory file is closed.");
+  xassert(positions.size() == forceNorms.size(),
+          "A force norm is needed for each position.");
+  size_t nbParticles = positions.size();
+
+  uint64_t offset = _file.tellp();
+  writeValue<uint64_t>(_file, nbParticles);
+  writeValue<double>(_file, time);
+
+  if (_codec) {
+    writeCompressedFrame(positions, forceNorms);
+  } else {
+    // Records of the frame are written at once
+    _buffer.resize(nbParticles * (_dimension + 1));
+    double* record = _buffer.data();
+    for (size_t i = 0; i < nbParticles; i++) {
+      for (size_t d = 0; d < _dimension; d++) record[d] = positions[i][d];
+      record[_dimension] = forceNorms[i];
+      record += _dimension + 1;
+    }
+    _file.write(reinterpret_cast<const char*>(_buffer.data()),
+                _buffer.size() * sizeof(double));
+  }
+  _index.push_back({offset, nbParticles, time});
+}
+
+void TrajectoryWriter::flush() { _file.flush(); }
+
+void TrajectoryWriter::close() {
+  uint64_t indexOffset = _file.tellp();
+  for (const IndexEntry& entry : _index) {
+    writeValue<uint64_t>(_file, entry.offset);
+    writeValue<uint64_t>(_file, entry.nbParticles);
+    writeValue<double>(_file, entry.time);
+  }
+  writeHeader(indexOffset);
+  _file.close();
+}
+
+TrajectoryReader::TrajectoryReader(const std::string& fileName)
+    : _fileName(fileName), _file(fileName, std::ios::binary) {
+  if (!_file) {
+    throw std::runtime_error("Error opening file for reading: " + fileName);
+  }
+  char magic[sizeof(TrajectoryWriter::MAGIC)];
+  _file.read(magic, sizeof(magic));
+  uint32_t version = readValue<uint32_t>(_file);
+  _dimension = readValue<uint32_t>(_file);
+  _nbValues = readValue<uint32_t>(_file);
+  uint64_t nbFrames = readValue<uint64_t>(_file);
+  uint64_t indexOffset = readValue<uint64_t>(_file);
+  bool compressed = readValue<uint32_t>(_file) != 0;
+  _blockSize = readValue<uint32_t>(_file);
+  uint64_t keyInterval = readValue<uint64_t>(_file);
+  double positionPrecision = readValue<double>(_file);
+  double forcePrecision = readValue<double>(_file);
+  Vector origin(3);
+  for (size_t d = 0; d < 3; d++) origin[d] = readValue<double>(_file);
+  if (!_file || std::memcmp(magic, TrajectoryWriter::MAGIC, sizeof(magic)) ||
+      version != TrajectoryWriter::VERSION || _dimension < 1 ||
+      _dimension > 3 || _nbValues != _dimension + 1 ||
+      (compressed && (_blockSize == 0 || keyInterval == 0 ||
+                      !(positionPrecision > 0) || !(forcePrecision > 0)))) {
+    throw std::runtime_error("Not a trajectory file: " + fileName);
+  }
+  if (compressed) {
+    _codec.emplace(positionPrecision, forcePrecision);
+    _codec->setKeyInterval(keyInterval);
+    _codec->setOrigin(origin);
+  }
+
+  _file.seekg(0, std::ios::end);
+  uint64_t fileSize = _file.tellg();
+  if (indexOffset == 0) {
+    scanFrames(fileSize);
+    return;
+  }
+
+  _file.seekg(indexOffset);
+  _offsets.resize(nbFrames);
+  _nbParticles.resize(nbFrames);
+  _times.resize(nbFrames);
+  for (size_t k = 0; k < nbFrames; k++) {
+    _offsets[k] = readValue<uint64_t>(_file);
+    _nbParticles[k] = readValue<uint64_t>(_file);
+    _times[k] = readValue<double>(_file);
+  }
+  if (!_file) {
+    throw std::runtime_error("Truncated trajectory index: " + fileName);
+  }
+}
+
+size_t TrajectoryReader::getNbParticles(size_t frame) const {
+  xassert(frame < getNbFrames(), "frame out of range.");
+  return _nbParticles[frame];
+}
+
+double TrajectoryReader::getTime(size_t frame) const {
+  xassert(frame < getNbFrames(), "frame out of range.");
+  return _times[frame];
+}
+
+uint64_t TrajectoryReader::getRecordsOffset(size_t frame) const {
+  xassert(frame < getNbFrames(), "frame out of range.");
+  if (_codec) {
+    throw std::runtime_error("Compressed frames have no records: " +
+                             _fileName);
+  }
+  return _offsets[frame] + TrajectoryWriter::FRAME_HEADER_SIZE;
+}
+
+void TrajectoryReader::readFrame(size_t frame, std::vector<Vector>& positions,
+                                 std::vector<double>& forceNorms) const {
+  size_t nbParticles = getNbParticles(frame);
+  positions.assign(nbParticles, Vector(_dimension));
+  forceNorms.resize(nbParticles);
+
+  if (_codec) {
+    // Decodes from the key frame, or from the last frame decoded
+    if (_decodedFrame != frame) {
+      size_t first = frame;
+      while (first != _decodedFrame + 1 && !isKeyFrame(first)) first--;
+      for (size_t k = first; k <= frame; k++) decodeFrame(k);
+    }
+
+    for (size_t i = 0; i < nbParticles; i++) {
+      for (size_t d = 0; d < _dimension; d++) {
+        positions[i][d] =
+            _codec->dequantizePosition(_decoded[d * nbParticles + i], d);
+      }
+      forceNorms[i] =
+          _codec->dequantizeForce(_decoded[_dimension * nbParticles + i]);
+    }
+    return;
+  }
+
+  std::vector<double> records(nbParticles * _nbValues);
+  _file.seekg(getRecordsOffset(frame));
+  _file.read(reinterpret_cast<char*>(records.data()),
+             records.size() * sizeof(double));
+  if (!_file) {
+    _file.clear();
+    throw std::runtime_error("Truncated trajectory frame: " + _fileName);
+  }
+
+  const double* record = records.data();
+  for (size_t i = 0; i < nbParticles; i++) {
+    for (size_t d = 0; d < _dimension; d++) positions[i][d] = record[d];
+    forceNorms[i] = record[_dimension];
+    record += _nbValues;
+  }
+}
+
+std::string TrajectoryReader::getGnuplotBinary(size_t frame) const {
+  std::stringstream ss;
+  ss << "binary skip=" << getRecordsOffset(frame)
+     << " record=" << getNbParticles(frame) << " format='";
+  for (size_t v = 0; v < _nbValues; v++) ss << "%double";
+  ss << "'";
+  return ss.str();
+}
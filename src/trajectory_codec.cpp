@@ -0,0 +1,197 @@
+#include "trajectory_codec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+/* ------------------------------- intern ------------------------------- */
+
+/* Smallest match of the LZ77 coder, and farthest one */
+static constexpr size_t MIN_MATCH = 4;
+static constexpr size_t MAX_OFFSET = 65535;
+static constexpr size_t HASH_BITS = 14;
+
+/* Small negative and positive values to small unsigned ones:
+   0, -1, 1, -2, 2... become 0, 1, 2, 3, 4... */
+static uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/* Length of a literal run or a match beyond its 15 of the token:
+   bytes of 255 then the rest */
+static void writeLength(size_t length, std::string& data) {
+  for (; length >= 255; length -= 255) data += static_cast<char>(255);
+  data += static_cast<char>(length);
+}
+
+static size_t readLength(const uint8_t* data, size_t size, size_t& pos) {
+  size_t length = 0;
+  uint8_t byte;
+  do {
+    if (pos >= size) throw std::runtime_error("Corrupted LZ77 data.");
+    byte = data[pos++];
+    length += byte;
+  } while (byte == 255);
+  return length;
+}
+
+/* A sequence: token (lengths of the literals and of the match),
+   literals, offset of the match. The last one has no match. */
+static void writeSequence(const uint8_t* literals, size_t nbLiterals,
+                          size_t offset, size_t matchLength,
+                          std::string& data) {
+  size_t literalNibble = std::min<size_t>(nbLiterals, 15);
+  size_t matchNibble =
+      matchLength == 0 ? 0 : std::min<size_t>(matchLength - MIN_MATCH, 15);
+  data += static_cast<char>(literalNibble << 4 | matchNibble);
+  if (literalNibble == 15) writeLength(nbLiterals - 15, data);
+  data.append(reinterpret_cast<const char*>(literals), nbLiterals);
+  if (matchLength == 0) return;
+
+  data += static_cast<char>(offset & 255);
+  data += static_cast<char>(offset >> 8);
+  if (matchNibble == 15) writeLength(matchLength - MIN_MATCH - 15, data);
+}
+
+/* ------------------------------- public ------------------------------- */
+
+TrajectoryCodec::TrajectoryCodec(double positionPrecision,
+                                 double forcePrecision)
+    : _positionPrecision(positionPrecision), _forcePrecision(forcePrecision) {
+  if (!(positionPrecision > 0) || !(forcePrecision > 0)) {
+    throw std::invalid_argument("Precisions must be positive.");
+  }
+}
+
+void TrajectoryCodec::setKeyInterval(size_t keyInterval) {
+  if (keyInterval == 0) {
+    throw std::invalid_argument("The key interval must be at least 1.");
+  }
+  _keyInterval = keyInterval;
+}
+
+int64_t TrajectoryCodec::quantizePosition(double coordinate, size_t d) const {
+  double origin = d < _origin.getDimension() ? _origin[d] : 0;
+  return std::llround((coordinate - origin) / _positionPrecision);
+}
+
+double TrajectoryCodec::dequantizePosition(int64_t quantized, size_t d) const {
+  double origin = d < _origin.getDimension() ? _origin[d] : 0;
+  return origin + quantized * _positionPrecision;
+}
+
+int64_t TrajectoryCodec::quantizeForce(double norm) const {
+  return std::llround(norm / _forcePrecision);
+}
+
+double TrajectoryCodec::dequantizeForce(int64_t quantized) const {
+  return quantized * _forcePrecision;
+}
+
+void TrajectoryCodec::compressBlock(const int64_t* values, size_t nbValues,
+                                    std::string& data) {
+  // Values on 4 bytes if they all fit
+  uint64_t maximum = 0;
+  for (size_t i = 0; i < nbValues; i++) {
+    maximum = std::max(maximum, zigzag(values[i]));
+  }
+  size_t width = maximum >> 32 ? 8 : 4;
+
+  // Byte k of value i at k * nbValues + i (little endian)
+  std::vector<uint8_t> shuffled(width * nbValues);
+  for (size_t i = 0; i < nbValues; i++) {
+    uint64_t value = zigzag(values[i]);
+    for (size_t k = 0; k < width; k++) {
+      shuffled[k * nbValues + i] = static_cast<uint8_t>(value >> (8 * k));
+    }
+  }
+
+  data += static_cast<char>(width);
+  compressLZ(shuffled.data(), shuffled.size(), data);
+}
+
+void TrajectoryCodec::decompressBlock(const char* data, size_t size,
+                                      int64_t* values, size_t nbValues) {
+  if (size == 0) throw std::runtime_error("Corrupted trajectory block.");
+  size_t width = static_cast<uint8_t>(data[0]);
+  std::vector<uint8_t> shuffled;
+  decompressLZ(data + 1, size - 1, shuffled);
+  if ((width != 4 && width != 8) || shuffled.size() != width * nbValues) {
+    throw std::runtime_error("Corrupted trajectory block.");
+  }
+
+  for (size_t i = 0; i < nbValues; i++) {
+    uint64_t value = 0;
+    for (size_t k = 0; k < width; k++) {
+      value |= static_cast<uint64_t>(shuffled[k * nbValues + i]) << (8 * k);
+    }
+    values[i] = unzigzag(value);
+  }
+}
+
+void TrajectoryCodec::compressLZ(const uint8_t* bytes, size_t size,
+                                 std::string& data) {
+  // Last position of each hash of 4 bytes
+  std::vector<size_t> table(size_t(1) << HASH_BITS, SIZE_MAX);
+  size_t anchor = 0;
+  size_t i = 0;
+  while (i + MIN_MATCH <= size) {
+    uint32_t sequence;
+    std::memcpy(&sequence, bytes + i, sizeof(sequence));
+    size_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+    size_t candidate = table[hash];
+    table[hash] = i;
+
+    if (candidate == SIZE_MAX || i - candidate > MAX_OFFSET ||
+        std::memcmp(bytes + candidate, bytes + i, MIN_MATCH) != 0) {
+      i++;
+      continue;
+    }
+
+    // Matches may overlap the bytes they copy (runs)
+    size_t length = MIN_MATCH;
+    while (i + length < size && bytes[candidate + length] == bytes[i + length])
+      length++;
+    writeSequence(bytes + anchor, i - anchor, i - candidate, length, data);
+    i += length;
+    anchor = i;
+  }
+  writeSequence(bytes + anchor, size - anchor, 0, 0, data);
+}
+
+void TrajectoryCodec::decompressLZ(const char* data, size_t size,
+                                   std::vector<uint8_t>& bytes) {
+  const uint8_t* input = reinterpret_cast<const uint8_t*>(data);
+  bytes.clear();
+  size_t pos = 0;
+  while (pos < size) {
+    uint8_t token = input[pos++];
+    size_t nbLiterals = token >> 4;
+    if (nbLiterals == 15) nbLiterals += readLength(input, size, pos);
+    if (nbLiterals > size - pos) {
+      throw std::runtime_error("Corrupted LZ77 data.");
+    }
+    bytes.insert(bytes.end(), input + pos, input + pos + nbLiterals);
+    pos += nbLiterals;
+    if (pos == size) break;  // Last sequence
+
+    if (pos + 2 > size) throw std::runtime_error("Corrupted LZ77 data.");
+    size_t offset = input[pos] | static_cast<size_t>(input[pos + 1]) << 8;
+    pos += 2;
+    size_t length = (token & 15) + MIN_MATCH;
+    if ((token & 15) == 15) length += readLength(input, size, pos);
+    if (offset == 0 || offset > bytes.size()) {
+      throw std::runtime_error("Corrupted LZ77 data.");
+    }
+
+    // Byte by byte, the match may overlap the bytes it copies
+    size_t source = bytes.size() - offset;
+    for (size_t k = 0; k < length; k++) bytes.push_back(bytes[source + k]);
+  }
+}
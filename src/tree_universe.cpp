@@ -0,0 +1,47 @@
+#include <tree_universe.hpp>
+#include <variant>
+
+/* ------------------------------- private ------------------------------- */
+
+bool TreeUniverse::isTreeInteraction(const Interaction& interaction) {
+  return std::holds_alternative<GravitationalParameters>(
+             interaction.getKernel()) &&
+         !interaction.hasCutoff();
+}
+
+/* ------------------------------- protected ------------------------------- */
+
+void TreeUniverse::applyInteractionForces() {
+  size_t nbTreeInteractions = 0;
+  _pairwiseInteractions.clear();
+  for (const Interaction& interaction : getActiveInteractions()) {
+    if (isTreeInteraction(interaction)) {
+      nbTreeInteractions++;
+    } else {
+      _pairwiseInteractions.push_back(interaction);
+    }
+  }
+
+  // Each particle only writes its own force,
+  // so blocks of particles need no buffer
+  if (nbTreeInteractions > 0) {
+    ParticleStore& particles = getParticles();
+    _tree.build(particles, getThreadPool());
+    runParticleBlocks([&](size_t first, size_t last) {
+      for (size_t k = 0; k < nbTreeInteractions; k++) {
+        _tree.applyGravitation(particles, first, last);
+      }
+    });
+  }
+
+  if (!_pairwiseInteractions.empty()) {
+    applyPairwiseForces(_pairwiseInteractions);
+  }
+}
+
+/* ------------------------------- public ------------------------------- */
+
+TreeUniverse::TreeUniverse(size_t dimension, double openingAngle)
+    : Universe(dimension), _tree(dimension) {
+  _tree.setOpeningAngle(openingAngle);
+}
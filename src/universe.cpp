@@ -1,180 +1,284 @@
-#include <cell.hpp>
+#include <algorithm>
+#include <async_writer.hpp>
 #include <cmath>
 #include <config.hpp>
-#include <fstream>
-#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <particle.hpp>
-#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <trajectory.hpp>
 #include <universe.hpp>
+#include <variant>
 #include <vector.hpp>
 #include <vector>
+#include <vtk_writer.hpp>
 #include <xassert.hpp>
 #ifdef SHOW_PROGRESS_INFOS
 #include <progressbar.hpp>
 #endif
 
-/* ---------------------------------------- intern
+/* ---------------------------------------- private
  * ---------------------------------------- */
 
-void writeData(std::ofstream& dataFile, const std::list<Particle>& particles) {
-  // Iterate through the particles in each time step
-  for (const Particle& p : particles) {
-    // Get the position data of the particle
-    std::vector<double> data = p.getPosition().getData();
-    // Write the position data to the file
-    for (double value : data) {
-      dataFile << value << " ";
+void Universe::updateForces() {
+  // Set all forces to 0 (already reset in a Störmer-Verlet step)
+  if (!_fusedStep) setForcesToZero();
+
+  // External forces
+  applyExternalForces();
+
+  // Forces from interactions
+  applyInteractionForces();
+}
+
+
+void Universe::updatesExtremumValues() {
+  _kernels.updateExtremumValues(_particles, _minPosition, _maxPosition,
+                                _maxForce);
+}
+
+double Universe::currentCineticEnergy() const {
+  double cineticEnergy = sumCineticEnergy(_kernels.cineticEnergy(_particles));
+  xassert(!std::isnan(cineticEnergy),
+          "Cinetic energy calculated is not a number (nan).");
+  return cineticEnergy;
+}
+
+void Universe::updatePaces(double timeStep) {
+  // Update the speeds, each block sums its cinetic energy
+  std::mutex mutex;
+  double cineticEnergy = 0;
+  runParticleBlocks([&](size_t first, size_t last) {
+    double blockEnergy =
+        _kernels.halfKickAndEnergy(_particles, timeStep, first, last);
+    std::lock_guard<std::mutex> lock(mutex);
+    cineticEnergy += blockEnergy;
+  });
+  cineticEnergy = sumCineticEnergy(cineticEnergy);
+  xassert(!std::isnan(cineticEnergy),
+          "Cinetic energy calculated is not a number (nan).");
+
+  limitCineticEnergy(cineticEnergy);
+}
+
+void Universe::limitCineticEnergy(double cineticEnergy) {
+  // Readapt speed if cinetic energy is too high
+  if (cineticEnergy > _cineticEnergyLimit) {
+    double betaFactor = std::sqrt(_cineticEnergyLimit / cineticEnergy);
+    for (Vector& speed : _particles.getSpeeds()) {
+      speed *= betaFactor;
     }
-    dataFile << p.getForce().norm();
-    dataFile << std::endl;  // Add newline after writing each position vector
   }
-  dataFile << std::endl << std::endl;  // Two new lines to separate groups
-}
-
-void writeDataVTK(std::ofstream& dataFile, const std::list<Particle>& particles,
-                  const size_t dimmension) {
-  // Header
-  dataFile << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" "
-              "byte_order=\"LittleEndian\">"
-           << std::endl;
-  dataFile << "<UnstructuredGrid>" << std::endl;
-  dataFile << "<Piece NumberOfPoints=\"" << particles.size()
-           << "\" NumberOfCells=\"0\">" << std::endl;
-  dataFile << "<Points>" << std::endl;
-
-  // Particles
-  // Position
-  dataFile
-      << "<DataArray type=\"Float32\" name=\"Position\" NumberOfComponents=\""
-      << dimmension << "\" format=\"ascii\">" << std::endl;
-  for (const Particle& p : particles) {
-    std::vector<double> data = p.getPosition().getData();
-    for (double value : data) {
-      dataFile << value << " ";
+}
+
+void Universe::updateUniformField() {
+  _uniformField = Vector(_dimension);
+  for (const ExternalForce& force : _forces) {
+    if (const auto* field = std::get_if<GravityField>(&force.getKernel())) {
+      _uniformField[_dimension - 1] -= field->G;
     }
   }
-  dataFile << std::endl;
-  dataFile << "</DataArray>" << std::endl;
-
-  // Speed
-  dataFile
-      << "<DataArray type=\"Float32\" name=\"Velocity\" NumberOfComponents=\""
-      << dimmension << "\" format=\"ascii\">" << std::endl;
-  for (const Particle& p : particles) {
-    std::vector<double> data = p.getSpeed().getData();
-    for (double value : data) {
-      dataFile << value << " ";
+}
+
+void Universe::stormerVerletStep(double timeStep) {
+  _fusedStep = true;
+  updatePositions(timeStep);
+  updateForces();
+  _fusedStep = false;
+  updatePaces(timeStep);
+}
+
+void Universe::startMultipleTimeStepping() {
+  size_t nbLevels = getNbLevels();
+  for (size_t level : _interactionLevels) {
+    if (level >= nbLevels) {
+      throw std::invalid_argument("Interaction level has no sub steps.");
     }
   }
-  dataFile << std::endl;
-  dataFile << "</DataArray>" << std::endl;
-
-  // Mass
-  dataFile << "<DataArray  type=\"Float32\" name=\"Masse\" format=\"ascii\">"
-           << std::endl;
-  for (const Particle& p : particles) {
-    dataFile << p.getMass() << " ";
+  for (size_t level : _forceLevels) {
+    if (level >= nbLevels) {
+      throw std::invalid_argument("External force level has no sub steps.");
+    }
   }
-  dataFile << std::endl;
-  dataFile << "</DataArray>" << std::endl;
-
-  dataFile << "</Points>" << std::endl;
-
-  // Cells
-  dataFile << "<Cells>" << std::endl;
-  dataFile
-      << "<DataArray  type=\"Int32\" name=\"connectivity\" format=\"ascii\">"
-      << std::endl;
-  dataFile << "</DataArray>" << std::endl;
-  dataFile << "<DataArray  type=\"Int32\" name=\"offsets\" format=\"ascii\">"
-           << std::endl;
-  dataFile << "</DataArray>" << std::endl;
-  dataFile << "<DataArray  type=\"Int8\" name=\"types\" format=\"ascii\">"
-           << std::endl;
-  dataFile << "</DataArray>" << std::endl;
-  dataFile << "</Cells>" << std::endl;
-
-  // Footer
-  dataFile << "</Piece>" << std::endl;
-  dataFile << "</UnstructuredGrid>" << std::endl;
-  dataFile << "</VTKFile>" << std::endl;
-}
 
-/* ---------------------------------------- private
- * ---------------------------------------- */
+  _levelInteractions.assign(nbLevels, {});
+  for (size_t k = 0; k < _interactions.size(); k++) {
+    _levelInteractions[_interactionLevels[k]].push_back(_interactions[k]);
+  }
+  _particles.setNbForceLevels(nbLevels);
+  for (size_t level = 0; level < nbLevels; level++) {
+    updateLevelForces(level);
+  }
+  sumLevelForces();
+}
 
-void Universe::updateForces() {
-  // Set all forces to 0
-  setForcesToZero();
+void Universe::updateLevelForces(size_t level) {
+  _activeLevel = level;
+  updateForces();
+  _activeLevel = ALL_LEVELS;
+  _particles.getLevelForces(level) = _particles.getForces();
+}
 
-  // External forces
-  applyExternalForces();
+void Universe::sumLevelForces() {
+  std::vector<Vector>& forces = _particles.getForces();
+  runParticleBlocks([&](size_t first, size_t last) {
+    for (size_t i = first; i < last; i++) {
+      forces[i] = _particles.getLevelForces(0)[i];
+    }
+    for (size_t level = 1; level < getNbLevels(); level++) {
+      const std::vector<Vector>& levelForces = _particles.getLevelForces(level);
+      for (size_t i = first; i < last; i++) forces[i] += levelForces[i];
+    }
+  });
+}
 
-  // Forces from interactions
-  applyInteractionForces();
+void Universe::kick(size_t level, double timeStep) {
+  const std::vector<Vector>& forces = _particles.getLevelForces(level);
+  runParticleBlocks([&](size_t first, size_t last) {
+    _kernels.kickSpeeds(_particles, forces, timeStep, first, last);
+  });
 }
 
-void Universe::applyInteractionForces() {
-  for (const Interaction& interaction : _interactions) {
-    // Calculates efficiently forces (for an ungridded universe)
-    for (auto it_i = _particles.begin(); it_i != std::prev(_particles.end());
-         ++it_i) {
-      for (auto it_j = std::next(it_i); it_j != _particles.end(); ++it_j) {
-        interaction(*it_i, *it_j);
-        interaction(*it_j, *it_i);
-      }
+void Universe::multipleTimeStep(size_t level, double timeStep) {
+  kick(level, timeStep / 2);
+
+  if (level + 1 == getNbLevels()) {
+    updatePositions(timeStep);
+  } else {
+    size_t nbSubSteps = _subSteps[level];
+    for (size_t k = 0; k < nbSubSteps; k++) {
+      multipleTimeStep(level + 1, timeStep / nbSubSteps);
     }
   }
+
+  updateLevelForces(level);
+  kick(level, timeStep / 2);
 }
 
-void Universe::updatesExtremumValues() {
-  for (const Particle& p : _particles) {
-    _maxPosition = max(_maxPosition, p.getPosition());
-    _minPosition = min(_minPosition, p.getPosition());
-    double pforce = p.getForce().norm();
-    if (pforce > _maxForce) {
-      _maxForce = pforce;
+void Universe::compositionStep(double timeStep, bool& forcesUpToDate) {
+  const std::vector<double>& kicks = _integrator.getKicks();
+  const std::vector<double>& drifts = _integrator.getDrifts();
+  for (size_t k = 0; k < kicks.size(); k++) {
+    if (k > 0) {
+      updatePositions(drifts[k - 1] * timeStep);
+      forcesUpToDate = false;
     }
+    if (kicks[k] == 0) continue;
+
+    if (!forcesUpToDate) {
+      updateForces();
+      forcesUpToDate = true;
+    }
+    const std::vector<Vector>& forces = _particles.getForces();
+    runParticleBlocks([&](size_t first, size_t last) {
+      _kernels.kickSpeeds(_particles, forces, kicks[k] * timeStep, first,
+                          last);
+    });
   }
 }
 
-double Universe::currentCineticEnergy() const {
-  double sum = 0;
-  for (const Particle& p : _particles) {
-    double speedNorm = p.getSpeed().norm();
-    sum += p.getMass() * speedNorm * speedNorm;
+void Universe::startBlockTimeSteps() {
+  if (getNbLevels() > 1) {
+    throw std::invalid_argument(
+        "Block time steps and multiple time stepping cannot be combined.");
   }
-  xassert(!std::isnan(sum), "Cinetic energy calculated is not a number (nan).");
-  return sum / 2;
+  _blockLevels.assign(_particles.size(), _maxBlockLevel);
+  updateForces();
+  _previousForces = _particles.getForces();
 }
 
-void Universe::updatePaces(double timeStep) {
-  // Update the speeds
-  for (Particle& p : _particles) {
-    Vector deltaSpeed = p.getForce();
-    deltaSpeed += p.getOldForce();
-    deltaSpeed *= 0.5 * timeStep / p.getMass();
-    p.addToSpeed(deltaSpeed);
+void Universe::applyActiveForces() {
+  std::vector<Vector>& forces = _particles.getForces();
+  for (size_t i : _activeParticles) {
+    forces[i] = Vector(_dimension);
+    Particle particle = _particles.at(i);
+    for (const ExternalForce& force : _forces) force.applyOn(particle);
   }
 
-  // Readapt speed if cinetic energy is too high
-  double cineticEnergy = currentCineticEnergy();
-  if (cineticEnergy > _cineticEnergyLimit) {
-    double betaFactor = std::sqrt(_cineticEnergyLimit / cineticEnergy);
-    for (Particle& p : _particles) {
-      p.multiplySpeed(betaFactor);
+  size_t nbParticles = _particles.size();
+  runForceTasks(
+      _activeParticles.size(), [&](size_t) { return nbParticles; },
+      [&](size_t k, PairBatch& batch, std::vector<Vector>& forces) {
+        size_t i = _activeParticles[k];
+        batch.clear();
+        batch.addSourceRange(0, i);
+        batch.addSourceRange(i + 1, nbParticles);
+        batch.applyForces(_particles, i, _particles, _interactions, false,
+                          forces);
+      });
+}
+
+/* The step just ended lasted timeStep / 2^level, during which the
+   force changed by about jerk * step: the time scale |a| / |jerk|
+   is |force| * step / |force change| */
+void Universe::chooseBlockLevel(size_t i, double timeStep, size_t tick) {
+  const Vector& force = _particles.getForces()[i];
+  size_t level = _blockLevels[i];
+  double step = std::ldexp(timeStep, -static_cast<int>(level));
+  double change = norm(force - _previousForces[i]);
+
+  size_t newLevel = 0;
+  if (change > 0) {
+    double maxStep = _blockAccuracy * step * force.norm() / change;
+    while (newLevel < _maxBlockLevel &&
+           std::ldexp(timeStep, -static_cast<int>(newLevel)) > maxStep) {
+      newLevel++;
     }
   }
+
+  // Longer steps one level at a time, when aligned with the next one
+  if (newLevel < level) {
+    size_t longerTicks = size_t(1) << (_maxBlockLevel - level + 1);
+    newLevel = tick % longerTicks == 0 ? level - 1 : level;
+  }
+  _blockLevels[i] = newLevel;
 }
 
-void Universe::setForcesToZero() {
-  for (Particle& p : _particles) {
-    p.setForceToZero();
+void Universe::blockTimeStep(double timeStep) {
+  size_t nbTicks = size_t(1) << _maxBlockLevel;
+  double tickLength = timeStep / nbTicks;
+  std::vector<Vector>& speeds = _particles.getSpeeds();
+  std::vector<Vector>& forces = _particles.getForces();
+  const std::vector<double>& masses = _particles.getMasses();
+
+  // Particle i is on a step of 2^(maxLevel - level) ticks
+  auto ticksOf = [&](size_t i) {
+    return size_t(1) << (_maxBlockLevel - _blockLevels[i]);
+  };
+  auto halfKick = [&](size_t i) {
+    speeds[i] += forces[i] * (0.5 * tickLength * ticksOf(i) / masses[i]);
+  };
+
+  for (size_t tick = 0; tick < nbTicks; tick++) {
+    for (size_t i = 0; i < _particles.size(); i++) {
+      if (tick % ticksOf(i) == 0) halfKick(i);
+    }
+
+    runParticleBlocks([&](size_t first, size_t last) {
+      _kernels.driftPositions(_particles, tickLength, first, last);
+    });
+
+    _activeParticles.clear();
+    for (size_t i = 0; i < _particles.size(); i++) {
+      if ((tick + 1) % ticksOf(i) == 0) {
+        _activeParticles.push_back(i);
+        _previousForces[i] = forces[i];
+      }
+    }
+    applyActiveForces();
+    for (size_t i : _activeParticles) {
+      halfKick(i);
+      chooseBlockLevel(i, timeStep, tick + 1);
+    }
   }
 }
 
+void Universe::setForcesToZero() {
+  _kernels.setForcesToZero(_particles);
+}
+
 /* ---------------------------------------- protected
  * ---------------------------------------- */
 
@@ -182,21 +286,67 @@ std::pair<Vector, Vector> Universe::getBounds() const {
   return std::pair<Vector, Vector>(_minPosition, _maxPosition);
 }
 
+bool Universe::isForcePhaseParallel() const {
+  if (getNbThreads() == 1) return false;
+  for (const Interaction& interaction : _interactions) {
+    if (!interaction.isBuiltin()) return false;
+  }
+  return true;
+}
+
 void Universe::updatePositions(double timeStep) {
-  for (Particle& p : _particles) {
-    Vector deltaPosition = p.getForce();
-    deltaPosition *= 0.5 * timeStep / p.getMass();
-    deltaPosition += p.getSpeed();
-    deltaPosition *= timeStep;
-    p.addToPosition(deltaPosition);
+  if (_fusedStep) {
+    // Each block extends its own extremum values, then merges them
+    std::mutex mutex;
+    double maxSquaredForce = _maxForce * _maxForce;
+    runParticleBlocks([&](size_t first, size_t last) {
+      Vector minPosition = _minPosition;
+      Vector maxPosition = _maxPosition;
+      double blockMaxSquaredForce = 0;
+      _kernels.kickDriftAndResetForces(_particles, timeStep, _uniformField,
+                                       first, last, minPosition, maxPosition,
+                                       blockMaxSquaredForce);
+      std::lock_guard<std::mutex> lock(mutex);
+      _minPosition = min(_minPosition, minPosition);
+      _maxPosition = max(_maxPosition, maxPosition);
+      maxSquaredForce = std::max(maxSquaredForce, blockMaxSquaredForce);
+    });
+    _maxForce = std::sqrt(maxSquaredForce);
+    return;
   }
+
+  runParticleBlocks([&](size_t first, size_t last) {
+    _kernels.driftPositions(_particles, timeStep, first, last);
+  });
+}
+
+void Universe::applyInteractionForces() {
+  applyPairwiseForces(getActiveInteractions());
+}
+
+void Universe::applyPairwiseForces(
+    const std::vector<Interaction>& interactions) {
+  // Each pair once, forces applied on both particles.
+  // First particles have more pairs, so they weigh more.
+  size_t nbParticles = _particles.size();
+  runForceTasks(nbParticles, [&](size_t i) { return nbParticles - i; },
+                [&](size_t i, PairBatch& batch, std::vector<Vector>& forces) {
+                  batch.clear();
+                  batch.addSourceRange(i + 1, nbParticles);
+                  batch.applyForces(_particles, i, _particles, interactions,
+                                    true, forces);
+                });
 }
 
 void Universe::applyExternalForces() {
-  for (const ExternalForce& force : _forces) {
-    for (Particle& p : _particles) {
-      force.applyOn(p);
+  for (size_t k = 0; k < _forces.size(); k++) {
+    if (!isLevelActive(_forceLevels[k])) continue;
+    // Gravity fields are the uniform field of a Störmer-Verlet step
+    if (_fusedStep &&
+        std::holds_alternative<GravityField>(_forces[k].getKernel())) {
+      continue;
     }
+    _forces[k].applyOnAll(_particles);
   }
 }
 
@@ -204,10 +354,14 @@ void Universe::applyExternalForces() {
  * ---------------------------------------- */
 
 Universe::Universe(size_t dimension)
-    : _minPosition(dimension), _maxPosition(dimension) {
+    : _dimension(dimension),
+      _kernels(getDimensionKernels(dimension)),
+      _particles(dimension),
+      _uniformField(dimension),
+      _minPosition(dimension),
+      _maxPosition(dimension) {
   xassert(dimension > 0 && dimension <= 3,
           "Universe dimension must be 1, 2 or 3.");
-  _dimension = dimension;
 }
 
 std::ostream& operator<<(std::ostream& strm, const Universe& univers) {
@@ -220,7 +374,7 @@ void Universe::addParticle(Vector pos, Vector speed, double mass,
   xassert(pos.getDimension() == speed.getDimension() &&
               pos.getDimension() == getDimension(),
           "Position and speed dimensions must match with universe dimension.");
-  _particles.emplace_back(pos, speed, mass, name);
+  _particles.add(pos, speed, mass, name);
 }
 
 void Universe::addParticle(std::initializer_list<double> posCoords,
@@ -232,7 +386,7 @@ void Universe::addParticle(std::initializer_list<double> posCoords,
 void Universe::addParticle(Vector pos, Vector speed, double mass) {
   std::string name = "Particle " + std::to_string(getNbParticles());
 
-  _particles.emplace_back(pos, speed, mass, name);
+  _particles.add(pos, speed, mass, name);
 }
 
 void Universe::addParticle(std::initializer_list<double> posCoords,
@@ -244,27 +398,85 @@ void Universe::addParticle(std::initializer_list<double> posCoords,
 void Universe::addInteraction(
     std::function<void(const Particle& source, Particle& target)>
         interactionFunction) {
-  _interactions.emplace_back(Interaction(interactionFunction));
+  addInteraction(Interaction(interactionFunction));
+}
+
+void Universe::addInteraction(const Interaction& interaction, size_t level) {
+  _interactions.push_back(interaction);
+  _interactionLevels.push_back(level);
+}
+
+void Universe::addInteraction(
+    std::function<void(const Particle& source, Particle& target)>
+        interactionFunction,
+    std::function<void(Particle& first, Particle& second)> pairFunction) {
+  addInteraction(Interaction(interactionFunction, pairFunction));
+}
+
+void Universe::setSubSteps(const std::vector<size_t>& subSteps) {
+  for (size_t nbSubSteps : subSteps) {
+    if (nbSubSteps == 0) {
+      throw std::invalid_argument("A level must make at least one step.");
+    }
+  }
+  _subSteps = subSteps;
+}
+
+void Universe::setBlockTimeSteps(size_t maxLevel, double accuracy) {
+  if (maxLevel >= 8 * sizeof(size_t)) {
+    throw std::invalid_argument("Block time step level is too high.");
+  }
+  if (accuracy <= 0) {
+    throw std::invalid_argument("Block time step accuracy must be positive.");
+  }
+  _maxBlockLevel = maxLevel;
+  _blockAccuracy = accuracy;
+}
+
+void Universe::setNbThreads(size_t nbThreads) {
+  _threadPool.reset();
+  _threadBatches.clear();
+  _threadForces.clear();
+
+  if (nbThreads == 1) return;
+  _threadPool = std::make_shared<ThreadPool>(nbThreads);
+  for (size_t thread = 0; thread < _threadPool->getNbThreads(); thread++) {
+    _threadBatches.emplace_back(_pairBatch.getKernels());
+  }
+  _threadForces.resize(_threadPool->getNbThreads());
+}
+
+void Universe::addExternalForce(const ExternalForce& force, size_t level) {
+  _forces.push_back(force);
+  _forceLevels.push_back(level);
 }
 
 void Universe::addExternalForce(
     std::function<void(Particle& target)> forceFunction) {
-  _forces.emplace_back(ExternalForce(forceFunction));
+  addExternalForce(ExternalForce(forceFunction));
 }
 
 void Universe::simulateStormerVerlet(double timeStep, double finalTime) {
   double currentTime = 0;
 
-#ifdef PNG_OUTPUT
-  // Open file for writing data
-  std::ofstream dataFile(_pastParticlesFileName);  // Write in binary
-  if (!dataFile) {
-    std::cerr << "Error opening file for writing." << std::endl;
-    abort();
+  bool multipleTimeStepping = getNbLevels() > 1;
+  bool blockTimeSteps = _maxBlockLevel > 0;
+  bool velocityVerlet = _integrator.isVelocityVerlet();
+  if (!velocityVerlet && (multipleTimeStepping || blockTimeSteps)) {
+    throw std::invalid_argument(
+        "Multiple time stepping and block time steps need velocity Verlet.");
+  }
+  bool stormerVerlet = velocityVerlet && !multipleTimeStepping &&
+                      !blockTimeSteps;
+  bool forcesUpToDate = true;
+  updateUniformField();
+  if (blockTimeSteps) {
+    startBlockTimeSteps();
+  } else if (multipleTimeStepping) {
+    startMultipleTimeStepping();
+  } else {
+    updateForces();
   }
-#endif
-
-  updateForces();
 
 #ifdef SHOW_PROGRESS_INFOS
   size_t nbIterations = static_cast<size_t>(finalTime / timeStep);
@@ -273,66 +485,87 @@ void Universe::simulateStormerVerlet(double timeStep, double finalTime) {
   Progressbar bar(nbIterations);
 #endif
 
-#ifdef XML_OUTPUT
-  // Creates folder to store future generated VTK files
-  std::stringstream ss;
-  ss << "rm -rf VTKFiles; mkdir VTKFiles";
-  if (system(ss.str().c_str()) != 0) {
-    std::cerr << "Error while creating folder VTKFiles" << std::endl;
-    abort();
+#ifdef PNG_OUTPUT
+  // Frames of the past states, in a binary indexed file
+  std::optional<TrajectoryWriter> trajectory;
+  if (_trajectoryCodec) {
+    // Rounded from the lower bound of the universe, once it is known
+    TrajectoryCodec codec = *_trajectoryCodec;
+    Vector origin = getBounds().first;
+    bool finite = true;
+    for (size_t d = 0; d < _dimension; d++) {
+      finite = finite && std::isfinite(origin[d]);
+    }
+    if (finite) codec.setOrigin(origin);
+    trajectory.emplace(_pastParticlesFileName, _dimension, codec);
+  } else {
+    trajectory.emplace(_pastParticlesFileName, _dimension);
   }
 #endif
-
-  while (currentTime < finalTime) {
 #ifdef XML_OUTPUT
-    // Defines the name of the VTK file
-    int index = static_cast<int>(currentTime / timeStep);
-    std::ostringstream filename;
-    filename << "VTKFiles/particles_" << std::setfill('0') << std::setw(5)
-             << index << ".vtu";
-
-    // Open VTK file for each time step
-    std::ofstream dataFile(filename.str());
-    if (!dataFile) {
-      std::cerr << "Error opening file for writing." << std::endl;
-      abort();
-    }
+  // A VTK file per step, and their collection
+  VtkWriter vtk("VTKFiles", _dimension, _vtkEncoding);
+#endif
+  _outputSchedule.start(timeStep, finalTime);
+  _nbWrittenFrames = 0;
+  size_t step = 0;
+
+#if defined(PNG_OUTPUT) || defined(XML_OUTPUT)
+  // Frames are written by a thread while the next steps are computed
+  AsyncWriter output(_dimension, [&](const ParticleStore& particles,
+                                     double time) {
+#ifdef PNG_OUTPUT
+    trajectory->writeFrame(particles, time);
 #endif
-
-    // Updates extremum values
-    updatesExtremumValues();
-
-    // Copies particles into the history
 #ifdef XML_OUTPUT
-    writeDataVTK(dataFile, _particles, _dimension);
-    dataFile.close();
+    vtk.writeFrame(particles, time);
 #endif
-
-#ifdef PNG_OUTPUT
-    writeData(dataFile, _particles);
+  });
 #endif
 
-    // Updates positions
-    updatePositions(timeStep);
+  while (currentTime < finalTime) {
+    // Updates extremum values (in the drift of a Störmer-Verlet step)
+    if (!stormerVerlet) updatesExtremumValues();
 
-    // Register old forces
-    for (Particle& p : _particles) {
-      p.setOldForce(p.getForce());
+    // Copies particles into the history, on the steps scheduled
+    if (_outputSchedule.isOutputStep(step, currentTime)) {
+#if defined(PNG_OUTPUT) || defined(XML_OUTPUT)
+      output.push(_particles, currentTime);
+#endif
+      _nbWrittenFrames++;
     }
 
-    updateForces();
-    updatePaces(timeStep);
+    if (stormerVerlet) {
+      stormerVerletStep(timeStep);
+    } else {
+      if (blockTimeSteps) {
+        blockTimeStep(timeStep);
+      } else if (multipleTimeStepping) {
+        multipleTimeStep(0, timeStep);
+        sumLevelForces();
+      } else {
+        compositionStep(timeStep, forcesUpToDate);
+      }
+      limitCineticEnergy(currentCineticEnergy());
+    }
 
     // Updates time
     currentTime += timeStep;
     _nbPastStates++;
+    step++;
 
 #ifdef SHOW_PROGRESS_INFOS
     bar.update();
 #endif
   }
 
+#if defined(PNG_OUTPUT) || defined(XML_OUTPUT)
+  output.finish();
+#endif
 #ifdef PNG_OUTPUT
-  dataFile.close();
+  trajectory->close();
+#endif
+#ifdef XML_OUTPUT
+  vtk.close();
 #endif
 }
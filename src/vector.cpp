@@ -6,18 +6,6 @@
 
 /* --------------------------- public --------------------------- */
 
-void Vector::operator*=(double scalar) {
-  for (size_t i = 0; i < _dimension; ++i) _data[i] *= scalar;
-}
-
-void Vector::operator+=(const Vector& other) {
-  for (size_t i = 0; i < _dimension; ++i) _data[i] += other._data[i];
-}
-
-void Vector::operator-=(const Vector& other) {
-  for (size_t i = 0; i < _dimension; ++i) _data[i] -= other._data[i];
-}
-
 bool Vector::operator==(const Vector& other) const {
   xassert(_dimension == other._dimension, "Vectors dimensions must match.");
   for (size_t i = 0; i < _dimension; i++) {
@@ -54,32 +42,12 @@ bool Vector::isInBounds(const Vector& lowerBound,
   return true;
 }
 
-double Vector::norm() const {
+double Vector::norm() const { return std::sqrt(squaredNorm()); }
+
+double Vector::squaredNorm() const {
   double sum = 0;
   for (size_t i = 0; i < _dimension; ++i) sum += _data[i] * _data[i];
-  return std::sqrt(sum);
-}
-
-Vector min(Vector v1, Vector v2) {
-  xassert(v1.getDimension() == v2.getDimension(),
-          "Vectors must be of same dimension.");
-  size_t dim = v1.getDimension();
-  Vector result = v1;
-  for (size_t i = 0; i < dim; i++) {
-    if (v2._data[i] < result._data[i]) result._data[i] = v2._data[i];
-  }
-  return result;
-}
-
-Vector max(Vector v1, Vector v2) {
-  xassert(v1.getDimension() == v2.getDimension(),
-          "Vectors must be of same dimension.");
-  size_t dim = v1.getDimension();
-  Vector result = v1;
-  for (size_t i = 0; i < dim; i++) {
-    if (v2._data[i] > result._data[i]) result._data[i] = v2._data[i];
-  }
-  return result;
+  return sum;
 }
 
 std::ostream& operator<<(std::ostream& strm, const Vector& v) {
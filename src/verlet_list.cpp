@@ -0,0 +1,78 @@
+#include "verlet_list.hpp"
+
+#include <xassert.hpp>
+
+/* ------------------------------- public ------------------------------- */
+
+VerletList::VerletList(double cutoff, double skin)
+    : _cutoff(cutoff), _skin(skin) {
+  xassert(cutoff > 0, "Cut-off radius must be positive.");
+  xassert(skin > 0, "Skin must be positive.");
+}
+
+bool VerletList::needsRebuild(const ParticleStore& particles) const {
+  const std::vector<Vector>& positions = particles.getPositions();
+  if (positions.size() != _referencePositions.size()) return true;
+
+  double maxDisplacement2 = _skin * _skin / 4;
+  for (size_t i = 0; i < positions.size(); i++) {
+    if (squaredNorm(positions[i] - _referencePositions[i]) >
+        maxDisplacement2) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void VerletList::build(const ParticleStore& particles, const CellList& cells) {
+  xassert(cells.getCellSide() >= getRadius(),
+          "Cells must be at least as large as the list radius.");
+
+  const std::vector<Vector>& positions = particles.getPositions();
+  double radius2 = getRadius() * getRadius();
+  _rows.clear();
+  _ghostRows.clear();
+
+  // Pairs inside a cell, and with neighbour cells of greater index
+  for (size_t cell = 0; cell < cells.getNbCells(); cell++) {
+    IndexSpan cellParticles = cells.getCellParticles(cell);
+    for (const size_t* i = cellParticles.begin(); i != cellParticles.end();
+         i++) {
+      for (const size_t* j = i + 1; j != cellParticles.end(); j++) {
+        if (squaredNorm(positions[*j] - positions[*i]) < radius2) {
+          _rows.neighbours.push_back(*j);
+        }
+      }
+      for (size_t neighbour : cells.getForwardNeighbours(cell)) {
+        for (size_t j : cells.getCellParticles(neighbour)) {
+          if (squaredNorm(positions[j] - positions[*i]) < radius2) {
+            _rows.neighbours.push_back(j);
+          }
+        }
+      }
+      _rows.endRow(*i);
+    }
+  }
+
+  // Pairs with the ghosts of border cells
+  const std::vector<Vector>& ghostPositions = cells.getGhosts().getPositions();
+  for (size_t b = 0; b < cells.getNbBorderCells(); b++) {
+    size_t ghostsBegin = cells.getGhostStart(b);
+    size_t ghostsEnd = cells.getGhostStart(b + 1);
+    if (ghostsBegin == ghostsEnd) continue;
+
+    for (size_t neighbour : cells.getBorderNeighbours(b)) {
+      for (size_t t : cells.getCellParticles(neighbour)) {
+        for (size_t g = ghostsBegin; g < ghostsEnd; g++) {
+          if (squaredNorm(ghostPositions[g] - positions[t]) < radius2) {
+            _ghostRows.neighbours.push_back(g);
+          }
+        }
+        _ghostRows.endRow(t);
+      }
+    }
+  }
+
+  _referencePositions = positions;
+  _nbBuilds++;
+}
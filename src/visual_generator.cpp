@@ -2,7 +2,10 @@
 
 #include <config.hpp>
 #include <cstdlib>
+#include <optional>
 #include <progressbar.hpp>
+#include <stdexcept>
+#include <trajectory.hpp>
 #include <visual_generator.hpp>
 #include <xassert.hpp>
 
@@ -44,10 +47,9 @@ void VisualGenerator::writePhotoData() const {
   }
 
   // Write binary data in the file
-  for (const Particle& p : _universe->_particles) {
-    const std::vector<double>& vect = p.getPosition().getData();
-    dataFile.write(reinterpret_cast<const char*>(vect.data()),
-                   vect.size() * sizeof(*vect.data()));
+  for (const Vector& position : _universe->_particles.getPositions()) {
+    dataFile.write(reinterpret_cast<const char*>(position.data()),
+                   position.getDimension() * sizeof(*position.data()));
   }
 
   dataFile.close();
@@ -87,7 +89,10 @@ void VisualGenerator::writeVideoScript(size_t numberFrames) const {
                              _videoScriptName);
   }
 
-  size_t nbPastStates = _universe->_nbPastStates;
+  TrajectoryReader trajectory(_universe->_pastParticlesFileName);
+  size_t nbWrittenFrames = trajectory.getNbFrames();
+  xassert(nbWrittenFrames >= numberFrames,
+          "numberFrames must be lower than the number of frames written.");
 
   // Disable plot legend
   scriptFile << "unset key" << std::endl;
@@ -115,15 +120,40 @@ void VisualGenerator::writeVideoScript(size_t numberFrames) const {
   // Sets axes ranges
   setAxesRanges(scriptFile);
 
+  /* Each frame is read from its offset in the trajectory file,
+     instead of scanning the file for its index. Gnuplot cannot
+     read compressed frames: those of the video are decoded
+     in a file of records. */
+  size_t step = nbWrittenFrames / numberFrames;
+  std::string dataFileName = _universe->_pastParticlesFileName;
+  std::optional<TrajectoryReader> videoFrames;
+  if (trajectory.isCompressed()) {
+    TrajectoryWriter writer(_videoFramesFileName, trajectory.getDimension());
+    std::vector<Vector> positions;
+    std::vector<double> forceNorms;
+    for (size_t n = 0; n < numberFrames; n++) {
+      trajectory.readFrame(n * step, positions, forceNorms);
+      writer.writeFrame(positions, forceNorms, trajectory.getTime(n * step));
+    }
+    writer.close();
+    videoFrames.emplace(_videoFramesFileName);
+    dataFileName = _videoFramesFileName;
+  }
+
+  scriptFile << "array frames[" << numberFrames << "]" << std::endl;
+  for (size_t n = 0; n < numberFrames; n++) {
+    std::string binary = videoFrames ? videoFrames->getGnuplotBinary(n)
+                                     : trajectory.getGnuplotBinary(n * step);
+    scriptFile << "frames[" << n + 1 << "] = \"" << binary << "\""
+               << std::endl;
+  }
+
   // Writes for loop for images generation
-  size_t step = nbPastStates / numberFrames;
-  scriptFile << "n = 1" << std::endl
-             << "do for [i=0 : " << numberFrames * step - 1 << " : " << step
-             << "] {" << std::endl
+  scriptFile << "do for [n=1 : " << numberFrames << "] {" << std::endl
              << "    set output sprintf('" << _videoFolderName
              << "/img%03.0f.png',n)" << std::endl
              << std::endl;
-  writeVideoPlotCommand(scriptFile);
+  writeVideoPlotCommand(scriptFile, dataFileName);
 
 /* Here, we write directly in the gnuplot script a loading bar
    because otherwise we cannot access progress informations
@@ -144,22 +174,23 @@ void VisualGenerator::writeVideoScript(size_t numberFrames) const {
              << std::endl;
 #endif
 
-  scriptFile << "    n=n+1" << std::endl
-             << "}" << std::endl
+  scriptFile << "}" << std::endl
              << "system('echo')" << std::endl;
 
   scriptFile.close();
 }
 
-void VisualGenerator::writeVideoPlotCommand(std::ofstream& scriptFile) const {
+void VisualGenerator::writeVideoPlotCommand(
+    std::ofstream& scriptFile, const std::string& dataFileName) const {
+  // eval, to use the binary clause of the frame
+  scriptFile << "    eval sprintf(\"";
   if (_universe->getDimension() == 3) {
-    scriptFile << "    splot ";
+    scriptFile << "splot ";
   } else {
-    scriptFile << "    plot ";
+    scriptFile << "plot ";
   }
 
-  scriptFile << "'" << _universe->_pastParticlesFileName << "'"
-             << " index i using ";
+  scriptFile << "'" << dataFileName << "'" << " %s using ";
   if (colorPaletteCanBeUsed()) {
     scriptFile << dotsRange(_universe->_dimension + 1);  // + 1 for color column
   } else
@@ -171,7 +202,7 @@ void VisualGenerator::writeVideoPlotCommand(std::ofstream& scriptFile) const {
   if (colorPaletteCanBeUsed())
     scriptFile << " palette";  // For color palette usage
 
-  scriptFile << std::endl;
+  scriptFile << "\", frames[n])" << std::endl;
 }
 
 void VisualGenerator::writePhotoPlotCommand(std::ofstream& outFile) const {
@@ -262,10 +293,11 @@ void VisualGenerator::generatePhoto() const {
    Run script using data stored previously in the
    Stormer Verlet method execution */
 void VisualGenerator::generateVideo(size_t numberFrames) const {
-  size_t nbPastStates = _universe->_nbPastStates;
-  xassert(nbPastStates >= numberFrames,
-          "nbFrames must be lower than the number of states the universe has "
-          "been into.");
+  if (_universe->_nbWrittenFrames < numberFrames) {
+    throw std::invalid_argument(
+        "numberFrames must be lower than the number of frames written by "
+        "the last simulation.");
+  }
 
 #ifdef SHOW_PROGRESS_INFOS
   std::cerr << "Data writed in '" << _universe->_pastParticlesFileName << "'"
@@ -0,0 +1,183 @@
+#include "vtk_writer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "xassert.hpp"
+
+/* ------------------------------- intern ------------------------------- */
+
+static const char BASE64_DIGITS[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/* Appends size bytes encoded in base64, padded with '=' */
+static void appendBase64(std::string& data, const unsigned char* bytes,
+                         size_t size) {
+  for (size_t i = 0; i < size; i += 3) {
+    uint32_t group = bytes[i] << 16;
+    if (i + 1 < size) group |= bytes[i + 1] << 8;
+    if (i + 2 < size) group |= bytes[i + 2];
+    data += BASE64_DIGITS[(group >> 18) & 63];
+    data += BASE64_DIGITS[(group >> 12) & 63];
+    data += i + 1 < size ? BASE64_DIGITS[(group >> 6) & 63] : '=';
+    data += i + 2 < size ? BASE64_DIGITS[group & 63] : '=';
+  }
+}
+
+/* Declaration of an array of the appended section */
+static void writeArray(std::ofstream& file, const std::string& name,
+                       size_t nbComponents, size_t offset) {
+  file << "<DataArray type=\"Float32\" Name=\"" << name
+       << "\" NumberOfComponents=\"" << nbComponents
+       << "\" format=\"appended\" offset=\"" << offset << "\"/>" << std::endl;
+}
+
+/* ------------------------------- private ------------------------------ */
+
+void VtkWriter::appendBlock(std::string& data) const {
+  uint64_t nbBytes = _values.size() * sizeof(float);
+  const unsigned char* header =
+      reinterpret_cast<const unsigned char*>(&nbBytes);
+  const unsigned char* bytes =
+      reinterpret_cast<const unsigned char*>(_values.data());
+
+  // In base64, the header and the values are encoded separately
+  if (_encoding == BASE64) {
+    appendBase64(data, header, sizeof(nbBytes));
+    appendBase64(data, bytes, nbBytes);
+  } else {
+    data.append(reinterpret_cast<const char*>(header), sizeof(nbBytes));
+    data.append(reinterpret_cast<const char*>(bytes), nbBytes);
+  }
+}
+
+void VtkWriter::appendVectors(const std::vector<Vector>& vectors) {
+  _values.assign(3 * vectors.size(), 0);
+  for (size_t i = 0; i < vectors.size(); i++) {
+    for (size_t d = 0; d < _dimension; d++) {
+      _values[3 * i + d] = static_cast<float>(vectors[i][d]);
+    }
+  }
+  appendBlock(_appended);
+}
+
+/* ------------------------------- public ------------------------------- */
+
+VtkWriter::VtkWriter(const std::string& folderName, size_t dimension,
+                     VtkEncoding encoding)
+    : _folderName(folderName), _dimension(dimension), _encoding(encoding) {
+  xassert(dimension >= 1 && dimension <= 3, "dimension must be 1, 2 or 3.");
+
+  // Creates folder to store future generated VTK files
+  std::stringstream ss;
+  ss << "rm -rf " << _folderName << "; mkdir " << _folderName;
+  if (system(ss.str().c_str()) != 0) {
+    throw std::runtime_error("Error while creating folder: " + _folderName);
+  }
+}
+
+VtkWriter::~VtkWriter() {
+  if (_closed) return;
+  try {
+    close();
+  } catch (const std::runtime_error& error) {
+    std::cerr << error.what() << std::endl;
+  }
+}
+
+void VtkWriter::writeFrame(const ParticleStore& particles, double time) {
+  xassert(!_closed, "The VTK writer is closed.");
+
+  _appended.clear();
+  size_t positionsOffset = _appended.size();
+  appendVectors(particles.getPositions());
+  size_t speedsOffset = _appended.size();
+  appendVectors(particles.getSpeeds());
+
+  // Masses are encoded again only if the particles changed
+  if (particles.getIds() != _massesIds || _massesBlock.empty()) {
+    const std::vector<double>& masses = particles.getMasses();
+    _values.assign(masses.begin(), masses.end());
+    _massesBlock.clear();
+    appendBlock(_massesBlock);
+    _massesIds = particles.getIds();
+  }
+  size_t massesOffset = _appended.size();
+  _appended += _massesBlock;
+
+  std::ostringstream fileName;
+  fileName << "particles_" << std::setfill('0') << std::setw(5)
+           << _fileNames.size() << ".vtu";
+  std::string path = _folderName + "/" + fileName.str();
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Error opening file for writing: " + path);
+  }
+
+  file << "<?xml version=\"1.0\"?>" << std::endl
+       << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+          "byte_order=\"LittleEndian\" header_type=\"UInt64\">"
+       << std::endl
+       << "<UnstructuredGrid>" << std::endl
+       << "<Piece NumberOfPoints=\"" << particles.size()
+       << "\" NumberOfCells=\"0\">" << std::endl;
+
+  file << "<Points>" << std::endl;
+  writeArray(file, "Position", 3, positionsOffset);
+  file << "</Points>" << std::endl;
+
+  file << "<PointData Vectors=\"Velocity\" Scalars=\"Masse\">" << std::endl;
+  writeArray(file, "Velocity", 3, speedsOffset);
+  writeArray(file, "Masse", 1, massesOffset);
+  file << "</PointData>" << std::endl;
+
+  // No cells
+  file << "<Cells>" << std::endl
+       << "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">"
+       << "</DataArray>" << std::endl
+       << "<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">"
+       << "</DataArray>" << std::endl
+       << "<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">"
+       << "</DataArray>" << std::endl
+       << "</Cells>" << std::endl;
+
+  file << "</Piece>" << std::endl << "</UnstructuredGrid>" << std::endl;
+
+  // The data begins after the underscore
+  file << "<AppendedData encoding=\""
+       << (_encoding == BASE64 ? "base64" : "raw") << "\">" << std::endl
+       << "_";
+  file.write(_appended.data(), _appended.size());
+  file << std::endl << "</AppendedData>" << std::endl
+       << "</VTKFile>" << std::endl;
+
+  _fileNames.push_back(fileName.str());
+  _times.push_back(time);
+}
+
+void VtkWriter::close() {
+  _closed = true;
+  std::string path = _folderName + "/particles.pvd";
+  std::ofstream file(path);
+  if (!file) {
+    throw std::runtime_error("Error opening file for writing: " + path);
+  }
+
+  // Full precision, so that close times stay distinct
+  file << std::setprecision(17);
+  file << "<?xml version=\"1.0\"?>" << std::endl
+       << "<VTKFile type=\"Collection\" version=\"0.1\" "
+          "byte_order=\"LittleEndian\">"
+       << std::endl
+       << "<Collection>" << std::endl;
+  for (size_t k = 0; k < _fileNames.size(); k++) {
+    file << "<DataSet timestep=\"" << _times[k] << "\" part=\"0\" file=\""
+         << _fileNames[k] << "\"/>" << std::endl;
+  }
+  file << "</Collection>" << std::endl << "</VTKFile>" << std::endl;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file async_writer_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the AsyncWriter class.
+ *
+ * This file contains unit tests for the AsyncWriter class, which check
+ * that frames are written in order from snapshots of the particles,
+ * that memory stays bounded when the writer is slow, and that errors
+ * of the writer thread are thrown again.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <async_writer.hpp>
+#include <atomic>
+#include <chrono>
+#include <particle_store.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector.hpp>
+#include <vector>
+
+/**
+ * @brief Test the order and the content of the frames.
+ *
+ * This test checks that each frame is written once, in order, with
+ * the particles as they were when it was pushed, although they
+ * are moved just after.
+ */
+TEST(AsyncWriterTest, Snapshots) {
+  ParticleStore particles(2);
+  particles.add(Vector({0.0, 0.0}), Vector({1.0, 0.0}), 1.0, "");
+
+  std::vector<double> times;
+  std::vector<double> positions;
+  AsyncWriter writer(2, [&](const ParticleStore& frame, double time) {
+    times.push_back(time);
+    positions.push_back(frame.getPositions()[0][0]);
+    EXPECT_EQ(frame.getMasses()[0], 1.0);
+  });
+
+  for (size_t k = 0; k < 100; k++) {
+    writer.push(particles, 0.1 * k);
+    particles.getPositions()[0][0] += 1;
+  }
+  writer.finish();
+
+  ASSERT_EQ(times.size(), 100u);
+  for (size_t k = 0; k < 100; k++) {
+    EXPECT_EQ(times[k], 0.1 * k);
+    EXPECT_EQ(positions[k], 1.0 * k);
+  }
+}
+
+/**
+ * @brief Test the backpressure.
+ *
+ * This test checks that with a slow writer, pushes wait so that
+ * at most the number of snapshots are waiting to be written.
+ */
+TEST(AsyncWriterTest, Backpressure) {
+  ParticleStore particles(1);
+  particles.add(Vector({0.0}), Vector({0.0}), 1.0, "");
+
+  std::atomic<size_t> nbWritten(0);
+  AsyncWriter writer(1, [&](const ParticleStore&, double) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    nbWritten++;
+  });
+
+  for (size_t k = 0; k < 20; k++) {
+    writer.push(particles, k);
+    // The snapshot pushed and the one being written at most
+    EXPECT_GE(nbWritten + 2, k + 1);
+  }
+  writer.finish();
+  EXPECT_EQ(nbWritten, 20u);
+}
+
+/**
+ * @brief Test the errors of the writer.
+ *
+ * This test checks that an exception thrown while writing a frame
+ * is thrown again in the thread of the simulation.
+ */
+TEST(AsyncWriterTest, Error) {
+  ParticleStore particles(1);
+  AsyncWriter writer(1, [](const ParticleStore&, double time) {
+    if (time == 3) throw std::runtime_error("Disk full");
+  });
+
+  EXPECT_THROW(
+      {
+        for (size_t k = 0; k < 1000; k++) writer.push(particles, k);
+        writer.finish();
+      },
+      std::runtime_error);
+}
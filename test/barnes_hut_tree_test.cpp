@@ -0,0 +1,159 @@
+/**
+ * @file barnes_hut_tree_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the BarnesHutTree class.
+ *
+ * This file contains unit tests for the BarnesHutTree class, which
+ * compare the gravitation approximated by the tree with the
+ * gravitation computed on every pair.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <barnes_hut_tree.hpp>
+#include <cmath>
+#include <forces.hpp>
+#include <pair_batch.hpp>
+#include <particle_store.hpp>
+#include <thread_pool.hpp>
+#include <vector.hpp>
+
+/**
+ * @brief Adds a cluster of particles of different masses,
+ *        denser in its centre
+ * @param store
+ * @param nbParticles
+ */
+static void addCluster(ParticleStore& store, size_t nbParticles) {
+  size_t dimension = store.getDimension();
+  unsigned long seed = 12345;
+  auto random = [&]() {
+    seed = (seed * 6364136223846793005UL + 1442695040888963407UL);
+    return (seed >> 11) * (1.0 / 9007199254740992.0);
+  };
+  for (size_t i = 0; i < nbParticles; i++) {
+    Vector position(dimension);
+    double radius = random() * random();
+    for (size_t d = 0; d < dimension; d++) {
+      position[d] = radius * (2 * random() - 1);
+    }
+    store.add(position, Vector(dimension), 0.5 + random(), "");
+  }
+}
+
+/**
+ * @brief Forces of every pair
+ * @param store
+ * @return std::vector<Vector>
+ */
+static std::vector<Vector> directForces(const ParticleStore& store) {
+  ParticleStore copy = store;
+  std::vector<Interaction> interactions = {makeGravitationalInteraction()};
+  PairBatch batch;
+  for (size_t i = 0; i < copy.size(); i++) {
+    batch.clear();
+    batch.addSourceRange(i + 1, copy.size());
+    batch.applyForces(copy, i, copy, interactions, true);
+  }
+  return copy.getForces();
+}
+
+/**
+ * @brief Relative error of forces, sqrt(Σ |f - e|² / Σ |e|²)
+ * @param forces
+ * @param expected
+ * @return double
+ */
+static double relativeError(const std::vector<Vector>& forces,
+                            const std::vector<Vector>& expected) {
+  double error = 0, norm = 0;
+  for (size_t i = 0; i < forces.size(); i++) {
+    error += squaredNorm(forces[i] - expected[i]);
+    norm += squaredNorm(expected[i]);
+  }
+  return std::sqrt(error / norm);
+}
+
+/**
+ * @brief Test the tree without approximation.
+ *
+ * This test checks that with an opening angle of 0, every node
+ * is opened and forces are those of every pair.
+ */
+TEST(BarnesHutTreeTest, Exact) {
+  for (size_t dimension = 1; dimension <= 3; dimension++) {
+    ParticleStore store(dimension);
+    addCluster(store, 300);
+    std::vector<Vector> expected = directForces(store);
+
+    BarnesHutTree tree(dimension);
+    tree.setOpeningAngle(0);
+    tree.build(store);
+    tree.applyGravitation(store, 0, store.size());
+    EXPECT_LT(relativeError(store.getForces(), expected), 1e-12);
+  }
+}
+
+/**
+ * @brief Test the approximation of the tree.
+ *
+ * This test checks that the forces approximated are close to
+ * those of every pair, and closer with the quadrupole moments.
+ */
+TEST(BarnesHutTreeTest, Approximation) {
+  ParticleStore store(3);
+  addCluster(store, 2000);
+  std::vector<Vector> expected = directForces(store);
+
+  BarnesHutTree tree(3);
+  tree.setQuadrupole(false);
+  tree.build(store);
+  tree.applyGravitation(store, 0, store.size());
+  double monopoleError = relativeError(store.getForces(), expected);
+
+  ParticleStore quadrupoleStore(3);
+  addCluster(quadrupoleStore, 2000);
+  tree.setQuadrupole(true);
+  tree.build(quadrupoleStore);
+  tree.applyGravitation(quadrupoleStore, 0, quadrupoleStore.size());
+  double quadrupoleError = relativeError(quadrupoleStore.getForces(), expected);
+
+  EXPECT_LT(monopoleError, 1e-2);
+  EXPECT_LT(quadrupoleError, monopoleError);
+  EXPECT_GT(quadrupoleError, 0);
+}
+
+/**
+ * @brief Test the tree built by several threads.
+ *
+ * This test checks that the tree built with a pool has the same
+ * nodes and gives the same forces as the tree built by one thread.
+ */
+TEST(BarnesHutTreeTest, ParallelBuild) {
+  ParticleStore serialStore(2);
+  ParticleStore parallelStore(2);
+  addCluster(serialStore, 3000);
+  addCluster(parallelStore, 3000);
+
+  BarnesHutTree serialTree(2);
+  BarnesHutTree parallelTree(2);
+  serialTree.setSoftening(0.01);
+  parallelTree.setSoftening(0.01);
+  ThreadPool pool(3);
+  serialTree.build(serialStore);
+  parallelTree.build(parallelStore, &pool);
+  ASSERT_EQ(parallelTree.getNodes().size(), serialTree.getNodes().size());
+  EXPECT_NEAR(parallelTree.getNodes()[0].mass, serialTree.getNodes()[0].mass,
+              1e-9);
+
+  serialTree.applyGravitation(serialStore, 0, serialStore.size());
+  pool.parallelFor(parallelStore.size(), 100,
+                   [&](size_t first, size_t last, size_t) {
+                     parallelTree.applyGravitation(parallelStore, first, last);
+                   });
+  EXPECT_LT(relativeError(parallelStore.getForces(), serialStore.getForces()),
+            1e-12);
+}
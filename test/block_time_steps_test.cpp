@@ -0,0 +1,107 @@
+/**
+ * @file block_time_steps_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests of the block time steps of the Universe class.
+ *
+ * This file contains unit tests of the individual block time steps
+ * of the Universe class, which compare a hierarchical system
+ * integrated with block time steps with the same system integrated
+ * with the shortest step, and count the forces computed.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <external_force.hpp>
+#include <finite_universe.hpp>
+#include <forces.hpp>
+#include <particle.hpp>
+#include <stdexcept>
+#include <universe.hpp>
+#include <vector.hpp>
+
+/* Universe giving access to its particles */
+class TestUniverse : public Universe {
+ public:
+  using Universe::getParticles;
+  using Universe::Universe;
+};
+
+/**
+ * @brief Adds a star with a close planet, and far planets.
+ *        Each force computation on a particle is counted.
+ * @param universe
+ * @param nbForces
+ */
+static void addPlanetarySystem(Universe& universe, size_t& nbForces) {
+  universe.addParticle({0, 0}, {0, -3.162e-3}, 1);
+  universe.addParticle({0.1, 0}, {0, std::sqrt(10.0)}, 1e-3);
+  for (size_t k = 0; k < 10; k++) {
+    double radius = 3 + 0.5 * k;
+    double angle = 0.6 * k;
+    double speed = 1 / std::sqrt(radius);
+    universe.addParticle(
+        Vector({radius * std::cos(angle), radius * std::sin(angle)}),
+        Vector({-speed * std::sin(angle), speed * std::cos(angle)}), 1e-6);
+  }
+  universe.addInteraction(makeGravitationalInteraction());
+  universe.addExternalForce(ExternalForce([&](Particle&) { nbForces++; }));
+}
+
+/**
+ * @brief Test a hierarchical system.
+ *
+ * This test checks that the close planet and its star take short
+ * steps and far planets long ones, that positions are those of the
+ * shortest step for every particle, with far fewer forces computed.
+ */
+TEST(BlockTimeStepsTest, PlanetarySystem) {
+  size_t nbReferenceForces = 0;
+  TestUniverse reference(2);
+  addPlanetarySystem(reference, nbReferenceForces);
+  reference.simulateStormerVerlet(0.05 / 128, 1 - 0.05 / 256);
+
+  size_t nbForces = 0;
+  TestUniverse universe(2);
+  addPlanetarySystem(universe, nbForces);
+  universe.setBlockTimeSteps(8);
+  universe.simulateStormerVerlet(0.05, 1 - 0.025);
+
+  const std::vector<size_t>& levels = universe.getBlockLevels();
+  EXPECT_GE(levels[0], 6);
+  EXPECT_GE(levels[1], 6);
+  for (size_t i = 2; i < levels.size(); i++) EXPECT_LE(levels[i], 1);
+
+  const ParticleStore& expected = reference.getParticles();
+  const ParticleStore& particles = universe.getParticles();
+  for (size_t i = 0; i < particles.size(); i++) {
+    for (size_t d = 0; d < 2; d++) {
+      EXPECT_NEAR(particles.getPositions()[i][d],
+                  expected.getPositions()[i][d], 1e-4);
+    }
+  }
+  EXPECT_LT(4 * nbForces, nbReferenceForces);
+}
+
+/**
+ * @brief Test the settings checks.
+ *
+ * This test checks that block time steps are rejected with multiple
+ * time stepping and by finite universes.
+ */
+TEST(BlockTimeStepsTest, Unsupported) {
+  Universe universe(2);
+  EXPECT_THROW(universe.setBlockTimeSteps(4, 0), std::invalid_argument);
+  universe.addParticle({0, 0}, {0, 0}, 1);
+  universe.setBlockTimeSteps(4);
+  universe.setSubSteps({2});
+  EXPECT_THROW(universe.simulateStormerVerlet(0.1, 1), std::invalid_argument);
+
+  FiniteUniverse finite(Vector({0, 0}), Vector({1, 1}));
+  finite.addParticle({0.5, 0.5}, {0, 0}, 1);
+  finite.setBlockTimeSteps(4);
+  EXPECT_THROW(finite.simulateStormerVerlet(0.1, 1), std::invalid_argument);
+}
@@ -0,0 +1,211 @@
+/**
+ * @file cell_list_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the CellList class.
+ *
+ * This file contains unit tests for the CellList class, which check
+ * the particles of each cell after a fill, the neighbours of corner,
+ * edge and interior cells, the forward neighbours of the half-shell
+ * traversal, and the ghosts of the border cells of a PERIODIC box.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cell_list.hpp>
+#include <cmath>
+#include <dimension_kernels.hpp>
+#include <map>
+#include <particle_store.hpp>
+#include <vector.hpp>
+#include <vector>
+
+/**
+ * @brief Store of the tests in the box [0, 3]²: cell x + 3y of the
+ *        grid of side 1 holds x + 3y + 1 particles, added in an
+ *        order mixing the cells
+ * @return ParticleStore
+ */
+static ParticleStore makeGridStore() {
+  ParticleStore store(2);
+  for (size_t k = 0; k < 9; k++) {
+    for (size_t c = 0; c < 9; c++) {
+      if (k > c) continue;
+      double x = c % 3 + 0.1 + 0.08 * k;
+      double y = c / 3 + 0.9 - 0.08 * k;
+      store.add(Vector({x, y}), Vector({0, 0}), 1, "");
+    }
+  }
+  return store;
+}
+
+/**
+ * @brief Coordinate of the cell of side 1 containing a coordinate
+ * @param coordinate
+ * @return int
+ */
+static int cellCoordinate(double coordinate) {
+  return static_cast<int>(std::floor(coordinate));
+}
+
+/**
+ * @brief Indices of a span, in order
+ * @param span
+ * @return std::vector<size_t>
+ */
+static std::vector<size_t> toVector(IndexSpan span) {
+  return std::vector<size_t>(span.begin(), span.end());
+}
+
+/**
+ * @brief Test the particles of the cells after a fill.
+ *
+ * This test checks that each particle is in the cell containing it,
+ * by increasing index, including a particle on the upper bound, and
+ * that cells are enlarged to cover the universe exactly.
+ */
+TEST(CellListTest, Fill) {
+  const DimensionKernels& kernels = getDimensionKernels(2);
+  ParticleStore store = makeGridStore();
+  store.add(Vector({3, 3}), Vector({0, 0}), 1, "");
+  CellList cells(Vector({0, 0}), Vector({3, 3}), 1, kernels);
+  cells.fill(store);
+
+  ASSERT_EQ(cells.getNbCells(), 9u);
+  for (size_t c = 0; c < 9; c++) {
+    IndexSpan particles = cells.getCellParticles(c);
+    EXPECT_EQ(particles.size(), c == 8 ? 10u : c + 1);
+    EXPECT_TRUE(std::is_sorted(particles.begin(), particles.end()));
+    for (size_t i : particles) {
+      const Vector& position = store.getPositions()[i];
+      int x = std::min(cellCoordinate(position[0]), 2);
+      int y = std::min(cellCoordinate(position[1]), 2);
+      EXPECT_EQ(static_cast<size_t>(x + 3 * y), c);
+      EXPECT_EQ(cells.getParticleCell(i), c);
+    }
+  }
+
+  // 3.5 is not a multiple of 1: 3 cells of side 3.5 / 3
+  CellList stretched(Vector({0, 0}), Vector({3.5, 2}), 1, kernels);
+  EXPECT_EQ(stretched.getDimensions(), std::vector<int>({3, 2}));
+  EXPECT_DOUBLE_EQ(stretched.getCellSides()[0], 3.5 / 3);
+  EXPECT_DOUBLE_EQ(stretched.getCellSides()[1], 1);
+}
+
+/**
+ * @brief Test the neighbours of the cells.
+ *
+ * This test checks the neighbours of a corner, an edge and an interior
+ * cell in 2D, and of the interior cell in 3D.
+ */
+TEST(CellListTest, Neighbours) {
+  CellList cells(Vector({0, 0}), Vector({3, 3}), 1, getDimensionKernels(2));
+  EXPECT_EQ(toVector(cells.getNeighbours(0)), std::vector<size_t>({1, 3, 4}));
+  EXPECT_EQ(toVector(cells.getNeighbours(1)),
+            std::vector<size_t>({0, 2, 3, 4, 5}));
+  EXPECT_EQ(toVector(cells.getNeighbours(4)),
+            std::vector<size_t>({0, 1, 2, 3, 5, 6, 7, 8}));
+
+  CellList cells3D(Vector({0, 0, 0}), Vector({3, 3, 3}), 1,
+                   getDimensionKernels(3));
+  ASSERT_EQ(cells3D.getNbCells(), 27u);
+  EXPECT_EQ(cells3D.getNeighbours(0).size(), 7u);
+  EXPECT_EQ(cells3D.getNeighbours(13).size(), 26u);
+}
+
+/**
+ * @brief Test the forward neighbours of the half-shell traversal.
+ *
+ * This test checks that an interior cell has half of its neighbours
+ * forward (4 of 8 in 2D, 13 of 26 in 3D), those of greater index, and
+ * that each pair of neighbour cells is visited once.
+ */
+TEST(CellListTest, ForwardNeighbours) {
+  CellList cells(Vector({0, 0}), Vector({3, 3}), 1, getDimensionKernels(2));
+  EXPECT_EQ(toVector(cells.getForwardNeighbours(4)),
+            std::vector<size_t>({5, 6, 7, 8}));
+  EXPECT_EQ(toVector(cells.getForwardNeighbours(0)),
+            std::vector<size_t>({1, 3, 4}));
+  EXPECT_TRUE(cells.getForwardNeighbours(8).empty());
+
+  CellList cells3D(Vector({0, 0, 0}), Vector({3, 3, 3}), 1,
+                   getDimensionKernels(3));
+  std::vector<size_t> forward3D = toVector(cells3D.getForwardNeighbours(13));
+  ASSERT_EQ(forward3D.size(), 13u);
+  EXPECT_EQ(forward3D.front(), 14u);
+  EXPECT_EQ(forward3D.back(), 26u);
+
+  // Each pair of neighbour cells, once
+  size_t nbPairs = 0;
+  size_t nbForwardPairs = 0;
+  for (size_t c = 0; c < cells3D.getNbCells(); c++) {
+    nbPairs += cells3D.getNeighbours(c).size();
+    for (size_t n : cells3D.getForwardNeighbours(c)) {
+      EXPECT_GT(n, c);
+      nbForwardPairs++;
+    }
+  }
+  EXPECT_EQ(2 * nbForwardPairs, nbPairs);
+}
+
+/**
+ * @brief Test the ghosts of a PERIODIC box.
+ *
+ * This test checks that each border cell holds, from its ghost start,
+ * a copy of each particle of the intern cell on the other side of
+ * the box, moved by the size of the box, and that its neighbours are
+ * the intern cells next to it.
+ */
+TEST(CellListTest, PeriodicGhosts) {
+  ParticleStore store = makeGridStore();
+  CellList cells(Vector({0, 0}), Vector({3, 3}), 1, getDimensionKernels(2));
+  cells.fill(store);
+  cells.fillGhosts(store);
+
+  std::map<int, size_t> indexOfId;
+  for (size_t i = 0; i < store.size(); i++) indexOfId[store.getIds()[i]] = i;
+
+  // A 5x5 grid around the 3x3 intern cells
+  ASSERT_EQ(cells.getNbBorderCells(), 16u);
+  const ParticleStore& ghosts = cells.getGhosts();
+  EXPECT_EQ(cells.getGhostStart(0), 0u);
+  EXPECT_EQ(cells.getGhostStart(16), ghosts.size());
+  for (size_t b = 0; b < 16; b++) {
+    size_t first = cells.getGhostStart(b);
+    size_t last = cells.getGhostStart(b + 1);
+    ASSERT_LT(first, last);
+
+    // Border cell of the first ghost, and intern cell copied
+    const Vector& firstPosition = ghosts.getPositions()[first];
+    int x = cellCoordinate(firstPosition[0]);
+    int y = cellCoordinate(firstPosition[1]);
+    EXPECT_TRUE(x == -1 || x == 3 || y == -1 || y == 3);
+    size_t copied = (x + 3) % 3 + 3 * ((y + 3) % 3);
+    EXPECT_EQ(last - first, cells.getCellParticles(copied).size());
+
+    // Offset of the copies: the size of the box, towards the border
+    double offsetX = x - (x + 3) % 3;
+    double offsetY = y - (y + 3) % 3;
+    for (size_t g = first; g < last; g++) {
+      const Vector& position = ghosts.getPositions()[g];
+      EXPECT_EQ(cellCoordinate(position[0]), x);
+      EXPECT_EQ(cellCoordinate(position[1]), y);
+      size_t source = indexOfId.at(ghosts.getIds()[g]);
+      EXPECT_EQ(cells.getParticleCell(source), copied);
+      const Vector& sourcePosition = store.getPositions()[source];
+      EXPECT_DOUBLE_EQ(position[0], sourcePosition[0] + offsetX);
+      EXPECT_DOUBLE_EQ(position[1], sourcePosition[1] + offsetY);
+    }
+
+    std::vector<size_t> expected;
+    for (int j = std::max(y - 1, 0); j <= std::min(y + 1, 2); j++) {
+      for (int i = std::max(x - 1, 0); i <= std::min(x + 1, 2); i++) {
+        expected.push_back(i + 3 * j);
+      }
+    }
+    EXPECT_EQ(toVector(cells.getBorderNeighbours(b)), expected);
+  }
+}
@@ -0,0 +1,76 @@
+/**
+ * @file gridded_universe_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the GriddedUniverse class.
+ *
+ * This file contains unit tests for the GriddedUniverse class, which
+ * check that the half-shell traversal of the cells, visiting each
+ * pair once, gives the same forces as the full traversal, with and
+ * without the ghosts of a PERIODIC universe.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <forces.hpp>
+#include <gridded_universe.hpp>
+#include <vector.hpp>
+
+/* Universe giving access to its particles */
+class TestGriddedUniverse : public GriddedUniverse {
+ public:
+  using GriddedUniverse::getParticles;
+  using GriddedUniverse::GriddedUniverse;
+};
+
+/**
+ * @brief Simulates a few steps of a Lennard-Jones crystal close to the
+ *        borders of the universe
+ * @param halfShell traversal of the cells
+ * @param behavior
+ * @return ParticleStore particles at the end
+ */
+static ParticleStore simulate(bool halfShell, OOBBehavior behavior) {
+  TestGriddedUniverse universe(Vector({0, 0}), Vector({10, 10}), 2.5);
+  for (size_t i = 0; i < 10; i++) {
+    for (size_t j = 0; j < 10; j++) {
+      double jitter = 0.05 * std::sin(7.0 * i + 3.0 * j);
+      universe.addParticle(Vector({0.5 + i + jitter, 0.5 + j - jitter}),
+                           Vector({0.1 * jitter, 0.2}), 1);
+    }
+  }
+  universe.addInteraction(makeLennardJonesInteraction(1, 0.9, 2.5));
+  universe.setOOBBehavior(behavior);
+  universe.setHalfShell(halfShell);
+  universe.simulateStormerVerlet(0.001, 0.02);
+  return universe.getParticles();
+}
+
+/**
+ * @brief Test the half-shell traversal.
+ *
+ * This test checks that forces and positions after a few steps are
+ * the same with and without the half-shell traversal, in a REFLEXION
+ * universe and in a PERIODIC one, where ghosts act across the borders.
+ */
+TEST(GriddedUniverseTest, HalfShell) {
+  for (OOBBehavior behavior : {REFLEXION, PERIODIC}) {
+    ParticleStore half = simulate(true, behavior);
+    ParticleStore full = simulate(false, behavior);
+    ASSERT_EQ(half.size(), full.size());
+
+    double maxForce = 0;
+    for (size_t i = 0; i < half.size(); i++) {
+      for (size_t d = 0; d < 2; d++) {
+        EXPECT_NEAR(half.getForces()[i][d], full.getForces()[i][d], 1e-9);
+        EXPECT_NEAR(half.getPositions()[i][d], full.getPositions()[i][d],
+                    1e-12);
+        maxForce = std::max(maxForce, std::abs(full.getForces()[i][d]));
+      }
+    }
+    EXPECT_GT(maxForce, 0);
+  }
+}
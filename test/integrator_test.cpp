@@ -0,0 +1,161 @@
+/**
+ * @file integrator_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the Integrator class.
+ *
+ * This file contains unit tests for the Integrator class, which check
+ * the order of each scheme on an oscillator, the number of force
+ * computations of a step, the fused Störmer-Verlet step, and the
+ * invalid coefficients.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <external_force.hpp>
+#include <forces.hpp>
+#include <integrator.hpp>
+#include <particle.hpp>
+#include <stdexcept>
+#include <universe.hpp>
+#include <vector.hpp>
+
+/* Universe giving access to its particles */
+class TestUniverse : public Universe {
+ public:
+  using Universe::getParticles;
+  using Universe::Universe;
+};
+
+/**
+ * @brief Error on the position of an oscillator (x'' = -x, x(0) = 1)
+ *        after a time of 2
+ * @param integrator
+ * @param timeStep
+ * @param nbForces number of force computations
+ * @return double
+ */
+static double oscillatorError(const Integrator& integrator, double timeStep,
+                              size_t& nbForces) {
+  TestUniverse universe(1);
+  universe.addParticle({1}, {0}, 1);
+  universe.addExternalForce(ExternalForce([&](Particle& p) {
+    p.addToForceCoord(0, -p.getPosition()[0]);
+    nbForces++;
+  }));
+  universe.setIntegrator(integrator);
+  universe.simulateStormerVerlet(timeStep, 2 - timeStep / 2);
+  return std::abs(universe.getParticles().getPositions()[0][0] - std::cos(2));
+}
+
+/**
+ * @brief Test the order of the schemes.
+ *
+ * This test checks that halving the step divides the error
+ * by about 2^order, and that each step computes the forces
+ * the number of times given by the integrator.
+ */
+TEST(IntegratorTest, Order) {
+  for (const Integrator& integrator :
+       {makeVelocityVerletIntegrator(), makeYoshida4Integrator(),
+        makeForestRuthIntegrator(), makeOmelyanIntegrator()}) {
+    size_t nbForces = 0;
+    double error = oscillatorError(integrator, 0.1, nbForces);
+    EXPECT_EQ(nbForces, 1 + 20 * integrator.getNbForceComputations())
+        << integrator.getName();
+
+    double halfStepError = oscillatorError(integrator, 0.05, nbForces);
+    double ratio = error / halfStepError;
+    double expected = std::pow(2, integrator.getOrder());
+    EXPECT_GT(ratio, 0.8 * expected) << integrator.getName();
+    EXPECT_LT(ratio, 1.2 * expected) << integrator.getName();
+  }
+}
+
+/**
+ * @brief Test the cost of the accuracy.
+ *
+ * This test checks that a fourth order scheme with a step 4 times
+ * longer is more accurate than velocity Verlet, with fewer
+ * force computations.
+ */
+TEST(IntegratorTest, LongerSteps) {
+  size_t nbVerletForces = 0;
+  double verletError =
+      oscillatorError(makeVelocityVerletIntegrator(), 0.02, nbVerletForces);
+  size_t nbOmelyanForces = 0;
+  double omelyanError =
+      oscillatorError(makeOmelyanIntegrator(), 0.08, nbOmelyanForces);
+  EXPECT_LT(omelyanError, verletError);
+  EXPECT_LE(nbOmelyanForces, nbVerletForces);
+}
+
+/**
+ * @brief Adds a small block of particles bound by Lennard-Jones,
+ *        falling in a gravity field
+ * @param universe
+ */
+static void addFallingBlock(Universe& universe) {
+  double spaceStep = std::pow(2, 1.0 / 6);
+  for (size_t i = 0; i < 5; i++) {
+    for (size_t j = 0; j < 5; j++) {
+      universe.addParticle(Vector({i * spaceStep, j * spaceStep}),
+                           Vector({0.1 * j, -0.2 * i}), 1);
+    }
+  }
+  universe.addInteraction(makeLennardJonesInteraction(5, 1, 2.5));
+  universe.addExternalForce(makeGravitationalForce(12));
+}
+
+/**
+ * @brief Test the fused Störmer-Verlet step.
+ *
+ * This test checks that the Störmer-Verlet step, whose drift resets
+ * the forces to the gravity field and tracks the extremum values,
+ * gives the same particles and extremum values as separate kicks and
+ * drifts (multiple time stepping with a single level), on several
+ * threads.
+ */
+TEST(IntegratorTest, FusedStormerVerlet) {
+  TestUniverse fused(2);
+  addFallingBlock(fused);
+  fused.setNbThreads(3);
+  fused.simulateStormerVerlet(0.001, 0.1);
+
+  TestUniverse separate(2);
+  addFallingBlock(separate);
+  separate.setSubSteps({1});
+  separate.simulateStormerVerlet(0.001, 0.1);
+
+  const ParticleStore& expected = separate.getParticles();
+  const ParticleStore& particles = fused.getParticles();
+  for (size_t i = 0; i < particles.size(); i++) {
+    for (size_t d = 0; d < 2; d++) {
+      EXPECT_NEAR(particles.getPositions()[i][d],
+                  expected.getPositions()[i][d], 1e-10);
+      EXPECT_NEAR(particles.getSpeeds()[i][d], expected.getSpeeds()[i][d],
+                  1e-10);
+    }
+  }
+  EXPECT_NEAR(fused.getMaxForce(), separate.getMaxForce(), 1e-8);
+}
+
+/**
+ * @brief Test the invalid coefficients.
+ *
+ * This test checks that inconsistent schemes are rejected, as well
+ * as multiple time stepping with another scheme than velocity Verlet.
+ */
+TEST(IntegratorTest, Invalid) {
+  EXPECT_THROW(Integrator("", 2, {0.5, 0.5}, {0.5}), std::invalid_argument);
+  EXPECT_THROW(Integrator("", 2, {0.5}, {1}), std::invalid_argument);
+
+  Universe universe(1);
+  universe.addParticle({0}, {0}, 1);
+  universe.setIntegrator(makeYoshida4Integrator());
+  universe.setSubSteps({2});
+  EXPECT_THROW(universe.simulateStormerVerlet(0.1, 1), std::invalid_argument);
+}
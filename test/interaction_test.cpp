@@ -0,0 +1,120 @@
+/**
+ * @file interaction_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the Interaction class.
+ *
+ * This file contains unit tests for the Interaction class, which tests
+ * the cut-off radius and the forces applied on pairs of particles.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <forces.hpp>
+#include <interraction.hpp>
+#include <particle.hpp>
+#include <particle_store.hpp>
+#include <vector.hpp>
+
+/**
+ * @brief Test the cut-off radius.
+ *
+ * This test checks that no force is applied between particles
+ * farther than the cut-off radius.
+ */
+TEST(InteractionTest, Cutoff) {
+  ParticleStore store(2);
+  store.add(Vector({0.0, 0.0}), Vector(2), 1, "a");
+  store.add(Vector({3.0, 0.0}), Vector(2), 1, "b");
+  Particle first(store, 0);
+  Particle second(store, 1);
+
+  Interaction interaction = makeLennardJonesInteraction(1, 1, 2.5);
+  EXPECT_TRUE(interaction.hasCutoff());
+  EXPECT_FALSE(interaction.isInRange(first, second));
+
+  interaction.applyOnPair(first, second);
+  interaction(first, second);
+  EXPECT_EQ(first.getForce(), Vector({0.0, 0.0}));
+  EXPECT_EQ(second.getForce(), Vector({0.0, 0.0}));
+
+  second.setPosition(Vector({2.0, 0.0}));
+  EXPECT_TRUE(interaction.isInRange(first, second));
+  interaction(first, second);
+  EXPECT_NE(second.getForce(), Vector({0.0, 0.0}));
+}
+
+/**
+ * @brief Test forces applied on pairs.
+ *
+ * This test checks that forces applied at once on a pair are
+ * equal and opposite, and the same as computed in each direction.
+ */
+TEST(InteractionTest, Pair) {
+  ParticleStore store(3);
+  store.add(Vector({0.0, 0.0, 0.0}), Vector(3), 1, "a");
+  store.add(Vector({1.1, 0.3, -0.2}), Vector(3), 1, "b");
+  Particle first(store, 0);
+  Particle second(store, 1);
+
+  Interaction interaction = makeLennardJonesInteraction(1, 1, 2.5);
+  EXPECT_TRUE(interaction.isReciprocal());
+  interaction.applyOnPair(first, second);
+  Vector pairForce = second.getForce();
+  EXPECT_EQ(first.getForce() + pairForce, Vector({0.0, 0.0, 0.0}));
+
+  first.setForceToZero();
+  second.setForceToZero();
+  interaction(first, second);
+  EXPECT_EQ(second.getForce(), pairForce);
+}
+
+/**
+ * @brief Test the force shift.
+ *
+ * This test checks that the shifted force vanishes
+ * at the cut-off radius.
+ */
+TEST(InteractionTest, ForceShift) {
+  ParticleStore store(1);
+  store.add(Vector({0.0}), Vector(1), 1, "a");
+  store.add(Vector({2.5 - 1e-9}), Vector(1), 1, "b");
+  Particle first(store, 0);
+  Particle second(store, 1);
+
+  makeLennardJonesInteraction(1, 1, 2.5, true)(first, second);
+  EXPECT_NEAR(second.getForce()[0], 0.0, 1e-8);
+}
+
+/**
+ * @brief Test the custom interactions.
+ *
+ * This test checks that an interaction given by functions (slow path)
+ * applies the same forces as the built-in kernel.
+ */
+TEST(InteractionTest, Custom) {
+  ParticleStore store(2);
+  store.add(Vector({0.0, 0.0}), Vector(2), 1, "a");
+  store.add(Vector({1.2, 0.4}), Vector(2), 1, "b");
+  Particle first(store, 0);
+  Particle second(store, 1);
+
+  Interaction custom(
+      [](const Particle& source, Particle& target) {
+        lennardJonesInteraction(source, target, 1, 1);
+      },
+      2.5);
+  EXPECT_FALSE(custom.isBuiltin());
+  EXPECT_FALSE(custom.isReciprocal());
+  custom.applyOnPair(first, second);
+  Vector customForce = second.getForce();
+
+  first.setForceToZero();
+  second.setForceToZero();
+  makeLennardJonesInteraction(1, 1, 2.5).applyOnPair(first, second);
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT_NEAR(second.getForce()[i], customForce[i], 1e-12);
+  }
+}
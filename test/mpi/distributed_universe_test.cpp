@@ -0,0 +1,133 @@
+/**
+ * @file distributed_universe_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Tests of the DistributedUniverse class, run on several processes.
+ *
+ * This file contains tests of the DistributedUniverse class, which
+ * compare a simulation split between processes with the same
+ * simulation in a GriddedUniverse, and test the rebalancing of slabs.
+ * Run with mpirun -np N.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cmath>
+#include <distributed_universe.hpp>
+#include <forces.hpp>
+#include <gridded_universe.hpp>
+#include <vector.hpp>
+
+/* Universes giving access to their particles */
+
+class TestDistributedUniverse : public DistributedUniverse {
+ public:
+  using DistributedUniverse::DistributedUniverse;
+  using DistributedUniverse::getParticles;
+};
+
+class TestGriddedUniverse : public GriddedUniverse {
+ public:
+  using GriddedUniverse::getParticles;
+  using GriddedUniverse::GriddedUniverse;
+};
+
+/**
+ * @brief Adds a block of particles falling on the ground
+ * @param universe
+ * @param corner lower left corner of the block
+ */
+static void addBlock(FiniteUniverse& universe, const Vector& corner) {
+  double spaceStep = std::pow(2, 1.0 / 6);
+  for (size_t i = 0; i < 10; i++) {
+    for (size_t j = 0; j < 10; j++) {
+      universe.addParticle(corner + Vector({i * spaceStep, j * spaceStep}),
+                           Vector({1, -2}), 1);
+    }
+  }
+  universe.addInteraction(makeLennardJonesInteraction(5, 1, 2.5));
+  universe.addExternalForce(makeGravitationalForce(12));
+  universe.setOOBBehavior(REFLEXION);
+}
+
+/**
+ * @brief Test the distributed simulation.
+ *
+ * This test checks that particles owned by every process after
+ * a simulation are those of a GriddedUniverse running the same
+ * simulation, at the same positions.
+ */
+TEST(DistributedUniverseTest, SameAsGridded) {
+  Vector lowerBound({0, 0});
+  Vector upperBound({40, 30});
+
+  int firstId = ParticleStore::getParticleCount();
+  TestGriddedUniverse reference(lowerBound, upperBound, 2.5);
+  addBlock(reference, Vector({12, 5}));
+  reference.simulateStormerVerlet(0.001, 0.2);
+
+  int firstDistributedId = ParticleStore::getParticleCount();
+  TestDistributedUniverse universe(lowerBound, upperBound, 2.5);
+  addBlock(universe, Vector({12, 5}));
+  universe.setRebalancePeriod(20);
+  universe.simulateStormerVerlet(0.001, 0.2);
+
+  ASSERT_EQ(universe.getGlobalNbParticles(), 100);
+
+  const ParticleStore& expected = reference.getParticles();
+  const ParticleStore& particles = universe.getParticles();
+  for (size_t i = 0; i < particles.size(); i++) {
+    size_t k = particles.getIds()[i] - firstDistributedId;
+    ASSERT_EQ(expected.getIds()[k] - firstId, static_cast<int>(k));
+    for (size_t d = 0; d < 2; d++) {
+      EXPECT_NEAR(particles.getPositions()[i][d],
+                  expected.getPositions()[k][d], 1e-9);
+      EXPECT_NEAR(particles.getSpeeds()[i][d], expected.getSpeeds()[k][d],
+                  1e-9);
+    }
+  }
+}
+
+/**
+ * @brief Test the rebalancing of slabs.
+ *
+ * This test checks that slabs follow the particles, so that each
+ * process owns about the same number of particles.
+ */
+TEST(DistributedUniverseTest, Rebalance) {
+  TestDistributedUniverse universe(Vector({0, 0}), Vector({100, 30}), 2.5);
+  addBlock(universe, Vector({60, 5}));
+  universe.simulateStormerVerlet(0.001, 0.01);
+
+  const std::vector<int>& slabStarts = universe.getSlabStarts();
+  ASSERT_EQ(slabStarts.size(), universe.getNbRanks() + 1);
+  for (int r = 0; r < universe.getNbRanks(); r++) {
+    EXPECT_LT(slabStarts[r], slabStarts[r + 1]);
+  }
+
+  // A column of the block holds at most 30 particles
+  long long nbOwned = universe.getParticles().size();
+  long long average = 100 / universe.getNbRanks();
+  EXPECT_LE(std::abs(nbOwned - average), 30);
+}
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // Only the first process prints the results
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank != 0) {
+    ::testing::TestEventListeners& listeners =
+        ::testing::UnitTest::GetInstance()->listeners();
+    delete listeners.Release(listeners.default_result_printer());
+  }
+
+  int result = RUN_ALL_TESTS();
+  MPI_Finalize();
+  return result;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file output_schedule_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the OutputSchedule class.
+ *
+ * This file contains unit tests for the OutputSchedule class, which
+ * check the steps written with a stride, a number of frames and a list
+ * of times, and the frames written by a simulation.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <config.hpp>
+#include <output_schedule.hpp>
+#include <stdexcept>
+#include <trajectory.hpp>
+#include <universe.hpp>
+#include <vector.hpp>
+#include <vector>
+
+/**
+ * @brief Steps written by a schedule during a simulation
+ * @param schedule
+ * @param timeStep
+ * @param finalTime
+ * @return std::vector<size_t>
+ */
+static std::vector<size_t> outputSteps(OutputSchedule schedule,
+                                       double timeStep, double finalTime) {
+  schedule.start(timeStep, finalTime);
+  std::vector<size_t> steps;
+  double time = 0;
+  for (size_t step = 0; time < finalTime; step++) {
+    if (schedule.isOutputStep(step, time)) steps.push_back(step);
+    time += timeStep;
+  }
+  return steps;
+}
+
+/**
+ * @brief Test the stride and the number of frames.
+ *
+ * This test checks that a stride writes every k-th step, and that
+ * frames are spread evenly over the steps of the simulation.
+ */
+TEST(OutputScheduleTest, StrideAndFrameCount) {
+  EXPECT_EQ(outputSteps(makeStrideSchedule(3), 0.1, 1.0),
+            std::vector<size_t>({0, 3, 6, 9}));
+  EXPECT_EQ(outputSteps(makeEveryStepSchedule(), 0.25, 1.0),
+            std::vector<size_t>({0, 1, 2, 3}));
+
+  OutputSchedule schedule = makeFrameCountSchedule(4);
+  schedule.start(0.01, 1.0);
+  EXPECT_EQ(schedule.getNbSteps(), 100u);
+  EXPECT_EQ(outputSteps(schedule, 0.01, 1.0),
+            std::vector<size_t>({0, 25, 50, 75}));
+
+  EXPECT_THROW(makeStrideSchedule(0), std::invalid_argument);
+}
+
+/**
+ * @brief Test a number of frames greater than the number of steps.
+ *
+ * This test checks that the frames are clamped to the steps of the
+ * simulation, each step being written once and counted once.
+ */
+TEST(OutputScheduleTest, FewerStepsThanFrames) {
+  OutputSchedule schedule = makeFrameCountSchedule(10);
+  schedule.start(0.25, 1.0);
+  EXPECT_EQ(schedule.getNbSteps(), 4u);
+  EXPECT_EQ(schedule.getNbFrames(), 4u);
+  EXPECT_EQ(outputSteps(schedule, 0.25, 1.0),
+            std::vector<size_t>({0, 1, 2, 3}));
+
+  Universe universe(1);
+  universe.addParticle(Vector({0.0}), Vector({1.0}), 1.0);
+  universe.setOutputSchedule(makeFrameCountSchedule(10));
+  universe.simulateStormerVerlet(0.25, 1.0);
+  EXPECT_EQ(universe.getNbWrittenFrames(), 4u);
+}
+
+/**
+ * @brief Test the list of times.
+ *
+ * This test checks that the step closest to each time is written,
+ * once when several times are closest to the same step.
+ */
+TEST(OutputScheduleTest, Times) {
+  EXPECT_EQ(outputSteps(makeTimesSchedule({0.5, 0.0, 0.31, 0.29, 2.0}), 0.1,
+                        1.0),
+            std::vector<size_t>({0, 3, 5}));
+}
+
+/**
+ * @brief Test the frames written by a simulation.
+ *
+ * This test checks that every step is still counted as a past state,
+ * but only the frames scheduled are written.
+ */
+TEST(OutputScheduleTest, Simulation) {
+  Universe universe(1);
+  universe.addParticle(Vector({0.0}), Vector({1.0}), 1.0);
+  universe.setOutputSchedule(makeFrameCountSchedule(10));
+  universe.simulateStormerVerlet(0.01, 1.0);
+
+  EXPECT_EQ(universe.getNbPastStates(), 100u);
+  EXPECT_EQ(universe.getNbWrittenFrames(), 10u);
+
+#ifdef PNG_OUTPUT
+  TrajectoryReader trajectory("pastParticles.trj");
+  ASSERT_EQ(trajectory.getNbFrames(), 10u);
+  EXPECT_NEAR(trajectory.getTime(1), 0.1, 1e-9);
+  EXPECT_NEAR(trajectory.getTime(9), 0.9, 1e-9);
+#endif
+}
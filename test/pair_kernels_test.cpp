@@ -0,0 +1,87 @@
+/**
+ * @file pair_kernels_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the batch pair kernels.
+ *
+ * This file contains unit tests for the pair kernels, which tests
+ * that every instruction set gives the same factors as the scalar
+ * kernels, including the last pairs of a batch and the cut-off.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <pair_kernels.hpp>
+#include <vector>
+
+/**
+ * @brief Squared distances from 0.81 to 8.6, crossing the cut-off
+ *        radius 2.5 (r² = 6.25), in an odd number of pairs.
+ */
+static std::vector<double> squaredDistances() {
+  std::vector<double> distances;
+  for (size_t i = 0; i < 43; i++) distances.push_back(0.81 + 0.185 * i);
+  return distances;
+}
+
+/**
+ * @brief Test the Lennard Jones kernels.
+ *
+ * This test checks that every instruction set gives the factors
+ * of the scalar kernel, with and without force shift.
+ */
+TEST(PairKernelsTest, LennardJones) {
+  std::vector<double> distances = squaredDistances();
+  for (double forceShift : {0.0, 0.01}) {
+    LennardJonesParameters params{5, 1, forceShift, 6.25};
+    std::vector<double> expected(distances.size(), 1);
+    getPairKernels(SimdLevel::SCALAR)
+        .lennardJones(distances.data(), expected.data(), distances.size(),
+                      params);
+
+    for (SimdLevel level :
+         {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+      std::vector<double> factors(distances.size(), 1);
+      getPairKernels(level).lennardJones(distances.data(), factors.data(),
+                                         distances.size(), params);
+      for (size_t i = 0; i < distances.size(); i++) {
+        EXPECT_NEAR(factors[i], expected[i], 1e-12 * std::abs(expected[i]));
+        if (distances[i] >= params.squaredCutoff) {
+          EXPECT_EQ(factors[i], 1);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Test the gravitational kernels.
+ *
+ * This test checks that every instruction set gives the factors
+ * m1 m2 / r³ of the scalar kernel.
+ */
+TEST(PairKernelsTest, Gravitational) {
+  std::vector<double> distances = squaredDistances();
+  std::vector<double> massProducts(distances.size(), 3);
+  GravitationalParameters params{6.25};
+
+  std::vector<double> expected(distances.size(), 0);
+  getPairKernels(SimdLevel::SCALAR)
+      .gravitational(distances.data(), massProducts.data(), expected.data(),
+                     distances.size(), params);
+  EXPECT_NEAR(expected[0], 3 / std::pow(0.9, 3), 1e-12);
+
+  for (SimdLevel level :
+       {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    std::vector<double> factors(distances.size(), 0);
+    getPairKernels(level).gravitational(distances.data(), massProducts.data(),
+                                        factors.data(), distances.size(),
+                                        params);
+    for (size_t i = 0; i < distances.size(); i++) {
+      EXPECT_NEAR(factors[i], expected[i], 1e-12 * std::abs(expected[i]));
+    }
+  }
+}
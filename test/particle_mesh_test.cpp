@@ -0,0 +1,150 @@
+/**
+ * @file particle_mesh_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the ParticleMesh and GridFft classes.
+ *
+ * This file contains unit tests for the particle mesh, which tests
+ * the Fourier transforms of grids, the split of the gravitation and
+ * the long-range forces against an Ewald sum.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <fft.hpp>
+#include <pair_kernels.hpp>
+#include <particle_mesh.hpp>
+#include <particle_store.hpp>
+#include <thread_pool.hpp>
+#include <vector.hpp>
+
+static const double pi = std::acos(-1.0);
+
+/**
+ * @brief Test the transforms of a grid.
+ *
+ * This test checks that the transform of a grid is its discrete
+ * Fourier transform, and that the inverse transform gives back
+ * the grid (times its size).
+ */
+TEST(ParticleMeshTest, GridFft) {
+  std::vector<size_t> dimensions = {4, 8, 2};
+  GridFft fft(dimensions);
+  ASSERT_EQ(fft.getSize(), 64);
+
+  std::vector<std::complex<double>> grid(64);
+  for (size_t p = 0; p < 64; p++) {
+    grid[p] = std::complex<double>(std::sin(p * 0.7), std::cos(p * 1.3));
+  }
+  std::vector<std::complex<double>> transformed = grid;
+  ThreadPool pool(3);
+  fft.transform(transformed, false, &pool);
+
+  for (size_t q = 0; q < 64; q++) {
+    size_t k[3] = {q % 4, (q / 4) % 8, q / 32};
+    std::complex<double> expected = 0;
+    for (size_t p = 0; p < 64; p++) {
+      size_t j[3] = {p % 4, (p / 4) % 8, p / 32};
+      double phase = 0;
+      for (size_t d = 0; d < 3; d++) {
+        phase -= 2 * pi * j[d] * k[d] / dimensions[d];
+      }
+      expected += grid[p] * std::polar(1.0, phase);
+    }
+    EXPECT_NEAR(std::abs(transformed[q] - expected), 0, 1e-10);
+  }
+
+  fft.transform(transformed, true);
+  for (size_t p = 0; p < 64; p++) {
+    EXPECT_NEAR(std::abs(transformed[p] / 64.0 - grid[p]), 0, 1e-12);
+  }
+  EXPECT_THROW(GridFft({4, 6}), std::invalid_argument);
+}
+
+/**
+ * @brief Test the split of the gravitation.
+ *
+ * This test checks that the short-range kernel plus the force
+ * of the long-range potential erf(r / 2rs) / r gives back
+ * the gravitational force.
+ */
+TEST(ParticleMeshTest, Split) {
+  double splitScale = 0.7;
+  GravitationalParameters shortRange{100, splitScale};
+  GravitationalParameters full{100};
+  for (double r : {0.1, 0.5, 1.0, 2.0, 3.0}) {
+    double u = r / (2 * splitScale);
+    double longRange =
+        (std::erf(u) - 2 * u / std::sqrt(pi) * std::exp(-u * u)) / (r * r * r);
+    EXPECT_NEAR(gravitationalFactor(r * r, 1, shortRange) + longRange,
+                gravitationalFactor(r * r, 1, full), 1e-12);
+  }
+
+  // Cut-off radius of periodic gravitation, 5 split scales
+  double squaredCutoff = 25 * splitScale * splitScale;
+  EXPECT_LT(gravitationalFactor(squaredCutoff, 1, shortRange),
+            1e-2 * gravitationalFactor(squaredCutoff, 1, full));
+}
+
+/**
+ * @brief Test the long-range forces.
+ *
+ * This test checks that the forces of the mesh are close to the
+ * long-range part of the gravitation of all the periodic images,
+ * computed by an Ewald sum on the wave vectors.
+ */
+TEST(ParticleMeshTest, EwaldSum) {
+  double side = 10;
+  double splitScale = 1;
+  Vector lowerBound({0, 0, 0});
+  Vector upperBound({side, side, side / 2});
+  ParticleStore store(3);
+  for (size_t i = 0; i < 12; i++) {
+    store.add(Vector({(i * 37 % 101) * side / 101, (i * 53 % 97) * side / 97,
+                      (i * 29 % 89) * side / 178}),
+              Vector(3), 0.5 + (i % 3) * 0.25, "");
+  }
+
+  ParticleMesh mesh(lowerBound, upperBound, splitScale);
+  ThreadPool pool(2);
+  mesh.applyForces(store, &pool);
+
+  // F_i = -4π / V Σ_j Σ_k m_i m_j exp(-k² rs²) / k² sin(k.r_ij) k
+  double volume = side * side * side / 2;
+  double squaredError = 0, squaredNorm = 0;
+  for (size_t i = 0; i < store.size(); i++) {
+    double expected[3] = {0, 0, 0};
+    for (int a = -8; a <= 8; a++) {
+      for (int b = -8; b <= 8; b++) {
+        for (int c = -16; c <= 16; c++) {
+          if (a == 0 && b == 0 && c == 0) continue;
+          double k[3] = {2 * pi * a / side, 2 * pi * b / side,
+                         4 * pi * c / side};
+          double k2 = k[0] * k[0] + k[1] * k[1] + k[2] * k[2];
+          double green = std::exp(-k2 * splitScale * splitScale) / k2;
+          for (size_t j = 0; j < store.size(); j++) {
+            if (j == i) continue;
+            double phase = 0;
+            for (size_t d = 0; d < 3; d++) {
+              phase += k[d] * (store.getPositions()[i][d] -
+                               store.getPositions()[j][d]);
+            }
+            double factor = -4 * pi / volume * store.getMasses()[i] *
+                            store.getMasses()[j] * green * std::sin(phase);
+            for (size_t d = 0; d < 3; d++) expected[d] += factor * k[d];
+          }
+        }
+      }
+    }
+    for (size_t d = 0; d < 3; d++) {
+      double error = store.getForces()[i][d] - expected[d];
+      squaredError += error * error;
+      squaredNorm += expected[d] * expected[d];
+    }
+  }
+  EXPECT_LT(std::sqrt(squaredError / squaredNorm), 2e-2);
+}
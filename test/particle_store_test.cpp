@@ -0,0 +1,79 @@
+/**
+ * @file particle_store_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the ParticleStore class.
+ *
+ * This file contains unit tests for the ParticleStore class, which tests
+ * adding particles, handles on stored particles, and removal of particles.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <particle.hpp>
+#include <particle_store.hpp>
+#include <vector.hpp>
+
+/**
+ * @brief Test adding particles.
+ *
+ * This test checks that added particles are stored at the end
+ * of every column, with a null force.
+ */
+TEST(ParticleStoreTest, Add) {
+  ParticleStore store(2);
+  store.add(Vector({1.0, 2.0}), Vector({0.1, 0.2}), 3.0, "first");
+  size_t index = store.add(Vector({4.0, 5.0}), Vector({0.4, 0.5}), 6.0, "b");
+
+  EXPECT_EQ(index, 1u);
+  EXPECT_EQ(store.size(), 2u);
+  EXPECT_EQ(store.getPositions()[1], Vector({4.0, 5.0}));
+  EXPECT_EQ(store.getSpeeds()[0], Vector({0.1, 0.2}));
+  EXPECT_EQ(store.getForces()[1], Vector({0.0, 0.0}));
+  EXPECT_EQ(store.getMasses()[0], 3.0);
+  EXPECT_EQ(store.getNames()[0], "first");
+}
+
+/**
+ * @brief Test handles on stored particles.
+ *
+ * This test checks that a Particle handle reads and writes
+ * directly in the columns of the store.
+ */
+TEST(ParticleStoreTest, Handle) {
+  ParticleStore store(2);
+  store.add(Vector({1.0, 2.0}), Vector({0.0, 0.0}), 1.0, "");
+  store.add(Vector({3.0, 4.0}), Vector({0.0, 0.0}), 2.0, "");
+
+  Particle p = store.at(1);
+  p.addToForce(Vector({1.0, -1.0}));
+  p.setPosCoord(0, 7.0);
+
+  EXPECT_EQ(p.getMass(), 2.0);
+  EXPECT_EQ(store.getForces()[1], Vector({1.0, -1.0}));
+  EXPECT_EQ(store.getPositions()[1], Vector({7.0, 4.0}));
+  EXPECT_EQ(store.getForces()[0], Vector({0.0, 0.0}));
+}
+
+/**
+ * @brief Test removing particles.
+ *
+ * This test checks that removeIf deletes the particles
+ * matching the predicate and keeps the order of the others.
+ */
+TEST(ParticleStoreTest, RemoveIf) {
+  ParticleStore store(1);
+  for (int i = 0; i < 5; i++) {
+    store.add(Vector({static_cast<double>(i)}), Vector({0.0}), 1.0, "");
+  }
+
+  const std::vector<Vector>& positions = store.getPositions();
+  store.removeIf([&positions](size_t i) { return positions[i][0] < 2.0; });
+
+  ASSERT_EQ(store.size(), 3u);
+  EXPECT_EQ(store.getPositions()[0], Vector({2.0}));
+  EXPECT_EQ(store.getPositions()[2], Vector({4.0}));
+  EXPECT_EQ(store.getMasses().size(), 3u);
+}
@@ -13,6 +13,7 @@
 #include <gtest/gtest.h>
 #include <math.h>
 
+#include <forces.hpp>
 #include <interraction.hpp>
 #include <particle.hpp>
 #include <vector.hpp>
@@ -175,3 +176,38 @@ TEST(ParticleTest, SetForceToZero) {
 
   EXPECT_EQ(p.getForce(), expectedForce);
 }
+
+/**
+ * @brief Test the isSameParticle function.
+ *
+ * This test checks that two handles on the same particle designate
+ * it, and that standalone particles, all at index 0 of their own
+ * store, are different.
+ */
+TEST(ParticleTest, IsSameParticle) {
+  Particle copy = p;
+  Particle other(pos, speed, mass, name);
+
+  EXPECT_TRUE(p.isSameParticle(copy));
+  EXPECT_EQ(other.getIndex(), p.getIndex());
+  EXPECT_FALSE(p.isSameParticle(other));
+}
+
+/**
+ * @brief Test a pair interaction between standalone particles.
+ *
+ * This test checks that two standalone particles, both at index 0,
+ * are not taken for the same one, and receive opposite forces.
+ */
+TEST(ParticleTest, StandalonePair) {
+  Particle first(Vector({0.0, 0.0}), Vector({0.0, 0.0}), 1.0, "first");
+  Particle second(Vector({2.0, 0.0}), Vector({0.0, 0.0}), 1.0, "second");
+
+  gravitationalPairInteraction(first, second);
+  lennardJonesPairInteraction(first, second, 1, 1);
+
+  Vector opposite = second.getForce();
+  opposite *= -1;
+  EXPECT_NE(first.getForce()[0], 0.0);
+  EXPECT_EQ(first.getForce(), opposite);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file respa_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests of the multiple time stepping of the Universe class.
+ *
+ * This file contains unit tests of the multiple time stepping (r-RESPA)
+ * of the Universe class, which compare it with the Störmer-Verlet
+ * method and with the exact movement of an oscillator, and count how
+ * often the forces of each level are computed.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <external_force.hpp>
+#include <forces.hpp>
+#include <particle.hpp>
+#include <stdexcept>
+#include <universe.hpp>
+#include <vector.hpp>
+
+/* Universe giving access to its particles */
+class TestUniverse : public Universe {
+ public:
+  using Universe::getParticles;
+  using Universe::Universe;
+};
+
+/**
+ * @brief Adds a small block of particles bound by Lennard-Jones
+ * @param universe
+ */
+static void addBlock(Universe& universe) {
+  double spaceStep = std::pow(2, 1.0 / 6);
+  for (size_t i = 0; i < 4; i++) {
+    for (size_t j = 0; j < 4; j++) {
+      universe.addParticle(Vector({i * spaceStep, j * spaceStep}),
+                           Vector({0.1 * i, -0.2 * j}), 1);
+    }
+  }
+  universe.addInteraction(makeLennardJonesInteraction(5, 1, 2.5));
+}
+
+/**
+ * @brief Position of a particle on a stiff spring (level 1)
+ *        under a constant weak force (level 0)
+ * @param subSteps
+ * @param timeStep
+ * @return double position after a time of 1
+ */
+static double oscillatorPosition(size_t subSteps, double timeStep) {
+  TestUniverse universe(1);
+  universe.addParticle({1}, {0}, 1);
+  universe.addExternalForce(
+      ExternalForce([](Particle& p) { p.addToForceCoord(0, 0.5); }), 0);
+  universe.addExternalForce(
+      ExternalForce([](Particle& p) {
+        p.addToForceCoord(0, -100 * p.getPosition()[0]);
+      }),
+      subSteps > 1 ? 1 : 0);
+  if (subSteps > 1) universe.setSubSteps({subSteps});
+  universe.simulateStormerVerlet(timeStep, 1 - timeStep / 2);
+  return universe.getParticles().getPositions()[0][0];
+}
+
+/**
+ * @brief Test a single level.
+ *
+ * This test checks that multiple time stepping with every force
+ * on the first level is the Störmer-Verlet method.
+ */
+TEST(RespaTest, SingleLevel) {
+  TestUniverse verlet(2);
+  addBlock(verlet);
+  verlet.simulateStormerVerlet(0.001, 0.1);
+
+  TestUniverse respa(2);
+  addBlock(respa);
+  respa.setSubSteps({1});
+  respa.simulateStormerVerlet(0.001, 0.1);
+
+  const ParticleStore& expected = verlet.getParticles();
+  const ParticleStore& particles = respa.getParticles();
+  ASSERT_EQ(particles.size(), expected.size());
+  for (size_t i = 0; i < particles.size(); i++) {
+    for (size_t d = 0; d < 2; d++) {
+      EXPECT_NEAR(particles.getPositions()[i][d],
+                  expected.getPositions()[i][d], 1e-12);
+      EXPECT_NEAR(particles.getSpeeds()[i][d], expected.getSpeeds()[i][d],
+                  1e-12);
+    }
+  }
+}
+
+/**
+ * @brief Test the number of force computations.
+ *
+ * This test checks that forces of the first level are computed
+ * once per step, and forces of the second level once per sub step.
+ */
+TEST(RespaTest, ForceComputations) {
+  size_t nbSlow = 0;
+  size_t nbFast = 0;
+  Universe universe(2);
+  universe.addParticle({0, 0}, {1, 0}, 1);
+  universe.addExternalForce(ExternalForce([&](Particle&) { nbSlow++; }), 0);
+  universe.addExternalForce(ExternalForce([&](Particle&) { nbFast++; }), 1);
+  universe.setSubSteps({5});
+  universe.simulateStormerVerlet(0.1, 0.95);
+
+  // 10 steps, plus the forces of the initial state
+  EXPECT_EQ(nbSlow, 11);
+  EXPECT_EQ(nbFast, 51);
+}
+
+/**
+ * @brief Test the accuracy.
+ *
+ * This test checks that sub steps of a stiff force give the
+ * accuracy of the Störmer-Verlet method with small steps.
+ */
+TEST(RespaTest, Accuracy) {
+  // x'' = 0.5 - 100 x, x(0) = 1, x'(0) = 0
+  double equilibrium = 0.005;
+  double exact = equilibrium + (1 - equilibrium) * std::cos(10.0);
+
+  double verletError = std::abs(oscillatorPosition(1, 0.02) - exact);
+  double respaError = std::abs(oscillatorPosition(10, 0.02) - exact);
+  double smallStepsError = std::abs(oscillatorPosition(1, 0.002) - exact);
+  EXPECT_LT(respaError, verletError / 10);
+  EXPECT_LT(respaError, 2 * smallStepsError);
+}
+
+/**
+ * @brief Test the levels checks.
+ *
+ * This test checks that levels without steps are rejected.
+ */
+TEST(RespaTest, InvalidLevels) {
+  Universe universe(2);
+  EXPECT_THROW(universe.setSubSteps({2, 0}), std::invalid_argument);
+
+  universe.addParticle({0, 0}, {0, 0}, 1);
+  universe.addExternalForce(makeGravitationalForce(1), 2);
+  universe.setSubSteps({2});
+  EXPECT_THROW(universe.simulateStormerVerlet(0.1, 1), std::invalid_argument);
+}
@@ -41,6 +41,9 @@ int main(int argc, char** argv) {
   univ.addInteraction(gravitationalInteraction);
 
   double timeStep = 0.1;  // 0.015;
+
+  // Halley takes shorter steps near the Sun, the others keep timeStep
+  univ.setBlockTimeSteps(6);
   double finalTime = 468.5;
 
   // Simulation calculation
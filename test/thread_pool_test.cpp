@@ -0,0 +1,190 @@
+/**
+ * @file thread_pool_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the ThreadPool class.
+ *
+ * This file contains unit tests for the ThreadPool class, which tests
+ * the sharing of tasks between threads, the forces computed
+ * in per-thread buffers and the cells filled by several threads.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cell_list.hpp>
+#include <chrono>
+#include <dimension_kernels.hpp>
+#include <forces.hpp>
+#include <pair_batch.hpp>
+#include <particle_store.hpp>
+#include <stdexcept>
+#include <thread_pool.hpp>
+#include <vector.hpp>
+
+/**
+ * @brief Test the sharing of tasks.
+ *
+ * This test checks that every task is run exactly once, by the thread
+ * of its chunk, and that errors of the threads are thrown again.
+ */
+TEST(ThreadPoolTest, ParallelFor) {
+  ThreadPool pool(3);
+  ASSERT_EQ(pool.getNbThreads(), 3);
+
+  std::vector<std::atomic<int>> runs(100);
+  std::vector<size_t> threads(100);
+  pool.parallelFor(100, 8, [&](size_t first, size_t last, size_t thread) {
+    for (size_t i = first; i < last; i++) {
+      runs[i]++;
+      threads[i] = thread;
+    }
+  });
+  for (size_t i = 0; i < 100; i++) {
+    EXPECT_EQ(runs[i], 1);
+    EXPECT_EQ(threads[i], (i / 8) % 3);
+  }
+
+  EXPECT_THROW(pool.run([](size_t thread) {
+    if (thread == 2) throw std::runtime_error("error");
+  }),
+               std::runtime_error);
+
+  // Pool is still usable after an error
+  std::atomic<int> nbRuns(0);
+  pool.run([&](size_t) { nbRuns++; });
+  EXPECT_EQ(nbRuns, 3);
+}
+
+/**
+ * @brief Test the forces computed by several threads.
+ *
+ * This test checks that the pairs shared between threads, each one
+ * adding forces in its own buffer, give once summed the forces
+ * computed by a single thread.
+ */
+TEST(ThreadPoolTest, ForceBuffers) {
+  ParticleStore store(2);
+  for (size_t i = 0; i < 12; i++) {
+    for (size_t j = 0; j < 12; j++) {
+      store.add(Vector({i * 1.1 + 0.03 * j, j * 1.1}), Vector(2), 1, "");
+    }
+  }
+  std::vector<Interaction> interactions = {
+      makeLennardJonesInteraction(1, 1, 2.5)};
+  size_t nbParticles = store.size();
+
+  PairBatch batch;
+  for (size_t i = 0; i < nbParticles; i++) {
+    batch.clear();
+    batch.addSourceRange(i + 1, nbParticles);
+    batch.applyForces(store, i, store, interactions, true);
+  }
+
+  ThreadPool pool(4);
+  std::vector<PairBatch> batches(pool.getNbThreads());
+  std::vector<std::vector<Vector>> buffers(pool.getNbThreads(),
+                                           std::vector<Vector>(nbParticles,
+                                                               Vector(2)));
+  pool.parallelFor(nbParticles, 5, [&](size_t first, size_t last,
+                                       size_t thread) {
+    for (size_t i = first; i < last; i++) {
+      batches[thread].clear();
+      batches[thread].addSourceRange(i + 1, nbParticles);
+      batches[thread].applyForces(store, i, store, interactions, true,
+                                  buffers[thread]);
+    }
+  });
+
+  for (size_t i = 0; i < nbParticles; i++) {
+    Vector sum(2);
+    for (const std::vector<Vector>& buffer : buffers) sum += buffer[i];
+    EXPECT_NEAR(sum[0], store.getForces()[i][0], 1e-9);
+    EXPECT_NEAR(sum[1], store.getForces()[i][1], 1e-9);
+  }
+}
+
+/**
+ * @brief Test the work stealing.
+ *
+ * This test checks that chunks follow the weights of the tasks,
+ * and that the chunks of a busy thread are run by the others.
+ */
+TEST(ThreadPoolTest, WorkStealing) {
+  ThreadPool pool(3);
+
+  // Tasks 0 to 9 weigh as much as tasks 10 to 99
+  std::vector<size_t> chunkSizes;
+  pool.makeChunks(100, [](size_t i) { return i < 10 ? 9.0 : 1.0; });
+  size_t first, last;
+  while (pool.takeChunk(0, first, last)) chunkSizes.push_back(last - first);
+  size_t nbTasks = 0;
+  for (size_t size : chunkSizes) nbTasks += size;
+  EXPECT_EQ(nbTasks, 100);
+  EXPECT_LT(chunkSizes.front(), chunkSizes.back());
+
+  // Thread 0 is stuck in its first chunk, others take the rest
+  std::vector<std::atomic<int>> runs(100);
+  std::vector<size_t> threads(100);
+  pool.parallelForWeighted(
+      100, [](size_t) { return 1.0; },
+      [&](size_t first, size_t last, size_t thread) {
+        if (thread == 0 && first == 0) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        for (size_t i = first; i < last; i++) {
+          runs[i]++;
+          threads[i] = thread;
+        }
+      });
+  size_t nbRunByFirst = 0;
+  for (size_t i = 0; i < 100; i++) {
+    EXPECT_EQ(runs[i], 1);
+    if (threads[i] == 0) nbRunByFirst++;
+  }
+  EXPECT_LT(nbRunByFirst, 33);
+}
+
+/**
+ * @brief Test the cells filled by several threads.
+ *
+ * This test checks that cells and ghosts filled with a pool
+ * are the same as with a single thread.
+ */
+TEST(ThreadPoolTest, CellListFill) {
+  ParticleStore store(2);
+  for (size_t i = 0; i < 500; i++) {
+    double x = (i * 37 % 101) * 0.099;
+    double y = (i * 53 % 97) * 0.103;
+    store.add(Vector({x, y}), Vector({1, 0}), 1, "");
+  }
+  const DimensionKernels& kernels = getDimensionKernels(2);
+  CellList serialCells(Vector({0, 0}), Vector({10, 10}), 1.5, kernels);
+  CellList parallelCells(Vector({0, 0}), Vector({10, 10}), 1.5, kernels);
+  ThreadPool pool(3);
+
+  serialCells.fill(store);
+  serialCells.fillGhosts(store);
+  parallelCells.fill(store, &pool);
+  parallelCells.fillGhosts(store, &pool);
+
+  for (size_t c = 0; c < serialCells.getNbCells(); c++) {
+    IndexSpan expected = serialCells.getCellParticles(c);
+    IndexSpan cell = parallelCells.getCellParticles(c);
+    ASSERT_EQ(cell.size(), expected.size());
+    EXPECT_TRUE(std::equal(cell.begin(), cell.end(), expected.begin()));
+  }
+
+  const ParticleStore& expectedGhosts = serialCells.getGhosts();
+  const ParticleStore& ghosts = parallelCells.getGhosts();
+  ASSERT_EQ(ghosts.size(), expectedGhosts.size());
+  for (size_t b = 0; b <= serialCells.getNbBorderCells(); b++) {
+    EXPECT_EQ(parallelCells.getGhostStart(b), serialCells.getGhostStart(b));
+  }
+  for (size_t g = 0; g < ghosts.size(); g++) {
+    EXPECT_EQ(ghosts.getPositions()[g], expectedGhosts.getPositions()[g]);
+    EXPECT_EQ(ghosts.getIds()[g], expectedGhosts.getIds()[g]);
+  }
+}
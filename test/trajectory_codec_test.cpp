@@ -0,0 +1,193 @@
+/**
+ * @file trajectory_codec_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the TrajectoryCodec class.
+ *
+ * This file contains unit tests for the compression of trajectory
+ * files, which check the LZ77 coder, the error of the frames read
+ * back in any order, the size of a compressed file against a file of
+ * records, and the rejection of invalid precisions.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <trajectory.hpp>
+#include <trajectory_codec.hpp>
+#include <vector.hpp>
+#include <vector>
+
+/**
+ * @brief Positions of frame k of the tests: particles slowly moving
+ *        on circles in [0, 10]^3
+ * @param k
+ * @param nbParticles
+ * @return std::vector<Vector>
+ */
+static std::vector<Vector> makePositions(size_t k, size_t nbParticles) {
+  std::vector<Vector> positions;
+  for (size_t i = 0; i < nbParticles; i++) {
+    double angle = 0.01 * k + i;
+    positions.push_back(Vector({5 + 4 * std::cos(angle),
+                                5 + 4 * std::sin(angle), 0.001 * i}));
+  }
+  return positions;
+}
+
+/**
+ * @brief Force norms of frame k of the tests
+ * @param k
+ * @param nbParticles
+ * @return std::vector<double>
+ */
+static std::vector<double> makeForceNorms(size_t k, size_t nbParticles) {
+  std::vector<double> forceNorms;
+  for (size_t i = 0; i < nbParticles; i++) {
+    forceNorms.push_back(100 + 10 * std::sin(0.02 * k + i));
+  }
+  return forceNorms;
+}
+
+/**
+ * @brief Size of a file
+ * @param fileName
+ * @return size_t
+ */
+static size_t fileSize(const std::string& fileName) {
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  return file.tellg();
+}
+
+/**
+ * @brief Test the LZ77 coder.
+ *
+ * This test checks that random bytes, runs and repeated patterns
+ * are decoded back, that repeated bytes are compressed, and that
+ * corrupted data is rejected.
+ */
+TEST(TrajectoryCodecTest, LZ) {
+  std::mt19937 generator(42);
+  std::vector<std::vector<uint8_t>> inputs(4);
+  for (size_t i = 0; i < 100000; i++) inputs[0].push_back(generator());
+  inputs[1].assign(100000, 7);
+  for (size_t i = 0; i < 100000; i++) inputs[2].push_back(i % 251 % 13);
+  inputs[3] = {1, 2, 3};
+
+  for (const std::vector<uint8_t>& input : inputs) {
+    std::string data;
+    TrajectoryCodec::compressLZ(input.data(), input.size(), data);
+    std::vector<uint8_t> output;
+    TrajectoryCodec::decompressLZ(data.data(), data.size(), output);
+    EXPECT_EQ(output, input);
+  }
+
+  std::string data;
+  TrajectoryCodec::compressLZ(inputs[1].data(), inputs[1].size(), data);
+  EXPECT_LT(data.size(), 1000u);
+
+  // A match before the start of the data
+  std::string corrupted = {char(0x10), 'a', char(5), char(0)};
+  std::vector<uint8_t> output;
+  EXPECT_THROW(
+      TrajectoryCodec::decompressLZ(corrupted.data(), corrupted.size(), output),
+      std::runtime_error);
+}
+
+/**
+ * @brief Test reading compressed frames in any order.
+ *
+ * This test checks that positions and force norms are read back with
+ * an error of at most half of their precision, sequentially and in
+ * any order, across key frames, blocks of particles, several threads
+ * and a change of the number of particles.
+ */
+TEST(TrajectoryCodecTest, RandomAccess) {
+  TrajectoryCodec codec(1e-4, 1e-2);
+  codec.setOrigin(Vector({0.0, 0.0, 0.0}));
+  codec.setKeyInterval(8);
+  codec.setNbThreads(2);
+  size_t nbFrames = 30;
+  auto nbParticles = [](size_t k) { return k < 20 ? 5000 : 4000; };
+  {
+    TrajectoryWriter writer("trajectory_codec_test.trj", 3, codec);
+    for (size_t k = 0; k < nbFrames; k++) {
+      writer.writeFrame(makePositions(k, nbParticles(k)),
+                        makeForceNorms(k, nbParticles(k)), 0.1 * k);
+    }
+  }
+
+  TrajectoryReader trajectory("trajectory_codec_test.trj");
+  ASSERT_TRUE(trajectory.isCompressed());
+  ASSERT_EQ(trajectory.getNbFrames(), nbFrames);
+  EXPECT_EQ(trajectory.getCodec().getKeyInterval(), 8u);
+  EXPECT_THROW(trajectory.getGnuplotBinary(0), std::runtime_error);
+
+  std::vector<size_t> order = {0, 1, 2, 13, 29, 5, 17, 18, 19, 20, 9, 9};
+  for (size_t k = 0; k < nbFrames; k++) order.push_back(k);
+  for (size_t k : order) {
+    std::vector<Vector> positions;
+    std::vector<double> forceNorms;
+    trajectory.readFrame(k, positions, forceNorms);
+    ASSERT_EQ(positions.size(), nbParticles(k));
+    EXPECT_EQ(trajectory.getTime(k), 0.1 * k);
+
+    std::vector<Vector> expectedPositions = makePositions(k, nbParticles(k));
+    std::vector<double> expectedNorms = makeForceNorms(k, nbParticles(k));
+    for (size_t i = 0; i < positions.size(); i++) {
+      for (size_t d = 0; d < 3; d++) {
+        ASSERT_LE(std::abs(positions[i][d] - expectedPositions[i][d]),
+                  0.5e-4 + 1e-12);
+      }
+      ASSERT_LE(std::abs(forceNorms[i] - expectedNorms[i]), 0.5e-2 + 1e-12);
+    }
+  }
+  std::remove("trajectory_codec_test.trj");
+}
+
+/**
+ * @brief Test the size of a compressed file.
+ *
+ * This test checks that a smooth trajectory is at least ten times
+ * smaller than its file of records.
+ */
+TEST(TrajectoryCodecTest, Ratio) {
+  TrajectoryCodec codec(1e-3, 1e-1);
+  codec.setOrigin(Vector({0.0, 0.0, 0.0}));
+  {
+    TrajectoryWriter raw("trajectory_codec_raw.trj", 3);
+    TrajectoryWriter compressed("trajectory_codec_test.trj", 3, codec);
+    for (size_t k = 0; k < 100; k++) {
+      raw.writeFrame(makePositions(k, 1000), makeForceNorms(k, 1000), k);
+      compressed.writeFrame(makePositions(k, 1000), makeForceNorms(k, 1000),
+                            k);
+    }
+  }
+
+  EXPECT_LT(10 * fileSize("trajectory_codec_test.trj"),
+            fileSize("trajectory_codec_raw.trj"));
+  std::remove("trajectory_codec_raw.trj");
+  std::remove("trajectory_codec_test.trj");
+}
+
+/**
+ * @brief Test the rejection of invalid parameters.
+ *
+ * This test checks that precisions must be positive and that
+ * key frames must be at least one frame apart.
+ */
+TEST(TrajectoryCodecTest, Invalid) {
+  EXPECT_THROW(TrajectoryCodec(0, 1), std::invalid_argument);
+  EXPECT_THROW(TrajectoryCodec(1, -1), std::invalid_argument);
+  EXPECT_THROW(TrajectoryCodec(NAN, 1), std::invalid_argument);
+
+  TrajectoryCodec codec(1, 1);
+  EXPECT_THROW(codec.setKeyInterval(0), std::invalid_argument);
+}
@@ -0,0 +1,140 @@
+/**
+ * @file trajectory_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the TrajectoryWriter and TrajectoryReader classes.
+ *
+ * This file contains unit tests for the binary trajectory file, which
+ * check that frames written are read back in any order, that a file
+ * which has not been closed is still readable, the gnuplot binary
+ * clause of a frame, and the rejection of other files.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <particle.hpp>
+#include <particle_store.hpp>
+#include <stdexcept>
+#include <trajectory.hpp>
+#include <vector.hpp>
+
+/**
+ * @brief Frame k of the tests: k + 1 particles, whose position and
+ *        force depend on k
+ * @param k
+ * @return ParticleStore
+ */
+static ParticleStore makeFrame(size_t k) {
+  ParticleStore store(2);
+  for (size_t i = 0; i <= k; i++) {
+    store.add(Vector({1.0 * k, 0.5 * i}), Vector({0.0, 0.0}), 1.0, "");
+    store.at(i).addToForce(Vector({3.0, 4.0 * k}));
+  }
+  return store;
+}
+
+/**
+ * @brief Checks that frame k of a trajectory is the one of makeFrame
+ * @param trajectory
+ * @param k
+ */
+static void expectFrame(const TrajectoryReader& trajectory, size_t k) {
+  std::vector<Vector> positions;
+  std::vector<double> forceNorms;
+  trajectory.readFrame(k, positions, forceNorms);
+
+  ASSERT_EQ(trajectory.getNbParticles(k), k + 1);
+  ASSERT_EQ(positions.size(), k + 1);
+  EXPECT_EQ(trajectory.getTime(k), 0.1 * k);
+  for (size_t i = 0; i <= k; i++) {
+    EXPECT_EQ(positions[i], Vector({1.0 * k, 0.5 * i}));
+    EXPECT_EQ(forceNorms[i], Vector({3.0, 4.0 * k}).norm());
+  }
+}
+
+/**
+ * @brief Test reading frames in any order.
+ *
+ * This test checks that frames of different sizes are read back
+ * from the index, in any order.
+ */
+TEST(TrajectoryTest, RandomAccess) {
+  {
+    TrajectoryWriter writer("trajectory_test.trj", 2);
+    for (size_t k = 0; k < 10; k++) writer.writeFrame(makeFrame(k), 0.1 * k);
+    EXPECT_EQ(writer.getNbFrames(), 10u);
+  }
+
+  TrajectoryReader trajectory("trajectory_test.trj");
+  EXPECT_EQ(trajectory.getDimension(), 2u);
+  ASSERT_EQ(trajectory.getNbFrames(), 10u);
+  for (size_t k : {7, 0, 9, 3, 3}) expectFrame(trajectory, k);
+
+  std::remove("trajectory_test.trj");
+}
+
+/**
+ * @brief Test reading a file which has not been closed.
+ *
+ * This test checks that frames flushed before the index is written
+ * are found by reading the header of each frame.
+ */
+TEST(TrajectoryTest, NotClosed) {
+  TrajectoryWriter writer("trajectory_test.trj", 2);
+  for (size_t k = 0; k < 4; k++) writer.writeFrame(makeFrame(k), 0.1 * k);
+  writer.flush();
+
+  TrajectoryReader trajectory("trajectory_test.trj");
+  ASSERT_EQ(trajectory.getNbFrames(), 4u);
+  for (size_t k = 0; k < 4; k++) expectFrame(trajectory, k);
+
+  writer.close();
+  std::remove("trajectory_test.trj");
+}
+
+/**
+ * @brief Test the gnuplot binary clause of a frame.
+ *
+ * This test checks that the clause skips the headers and the previous
+ * frames, and reads the records of the frame.
+ */
+TEST(TrajectoryTest, GnuplotBinary) {
+  {
+    TrajectoryWriter writer("trajectory_test.trj", 2);
+    for (size_t k = 0; k < 3; k++) writer.writeFrame(makeFrame(k), 0.1 * k);
+  }
+
+  TrajectoryReader trajectory("trajectory_test.trj");
+  size_t header = TrajectoryWriter::HEADER_SIZE;
+  size_t frameHeader = TrajectoryWriter::FRAME_HEADER_SIZE;
+  size_t record = 3 * sizeof(double);
+  EXPECT_EQ(trajectory.getRecordsOffset(0), header + frameHeader);
+  EXPECT_EQ(trajectory.getRecordsOffset(2),
+            header + 3 * frameHeader + 3 * record);
+  EXPECT_EQ(trajectory.getGnuplotBinary(2),
+            "binary skip=" + std::to_string(header + 3 * frameHeader +
+                                            3 * record) +
+                " record=3 format='%double%double%double'");
+
+  std::remove("trajectory_test.trj");
+}
+
+/**
+ * @brief Test opening other files.
+ *
+ * This test checks that files which are not trajectories,
+ * or do not exist, are rejected.
+ */
+TEST(TrajectoryTest, Invalid) {
+  {
+    std::ofstream file("trajectory_test.trj");
+    file << "1 2 3" << std::endl;
+  }
+  EXPECT_THROW(TrajectoryReader("trajectory_test.trj"), std::runtime_error);
+  std::remove("trajectory_test.trj");
+  EXPECT_THROW(TrajectoryReader("trajectory_test.trj"), std::runtime_error);
+}
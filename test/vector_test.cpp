@@ -130,3 +130,19 @@ TEST(VectorTest, OutputOperator) {
   std::string expectedOutput = "(1, 2, 3)";
   EXPECT_EQ(oss.str(), expectedOutput);
 }
+
+/**
+ * @brief Test chained arithmetic expressions.
+ *
+ * This test checks that an expression mixing additions, subtractions
+ * and scalar multiplications is evaluated coordinate by coordinate.
+ */
+TEST(VectorTest, ChainedExpression) {
+  Vector v1({1.0, 2.0, 3.0});
+  Vector v2({4.0, 5.0, 6.0});
+  Vector result = (v2 - v1) * 2.0 + v1;
+  Vector expected({7.0, 8.0, 9.0});
+
+  EXPECT_EQ(result, expected);
+  EXPECT_EQ(norm(v2 - v1), std::sqrt(27.0));
+}
@@ -0,0 +1,81 @@
+/**
+ * @file verlet_list_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the VerletList class.
+ *
+ * This file contains unit tests for the VerletList class, which tests
+ * the pairs found with the cells and the rebuild criterion.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cell_list.hpp>
+#include <dimension_kernels.hpp>
+#include <particle_store.hpp>
+#include <vector.hpp>
+#include <verlet_list.hpp>
+
+/**
+ * @brief Test the pairs of the list.
+ *
+ * This test checks that the list built with the cells has exactly
+ * the pairs closer than the list radius, each pair once.
+ */
+TEST(VerletListTest, Build) {
+  ParticleStore store(2);
+  for (size_t i = 0; i < 10; i++) {
+    for (size_t j = 0; j < 10; j++) {
+      store.add(Vector({0.37 * i + 0.05 * j, 0.41 * j}), Vector(2), 1, "p");
+    }
+  }
+
+  VerletList list(1.0, 0.2);
+  CellList cells(Vector({0, 0}), Vector({5, 5}), list.getRadius(),
+                 getDimensionKernels(2));
+  cells.fill(store);
+  list.build(store, cells);
+
+  size_t nbPairs = 0;
+  double radius2 = list.getRadius() * list.getRadius();
+  for (size_t i = 0; i < store.size(); i++) {
+    for (size_t j = i + 1; j < store.size(); j++) {
+      Vector delta = store.getPositions()[j] - store.getPositions()[i];
+      if (delta.squaredNorm() < radius2) nbPairs++;
+    }
+  }
+  EXPECT_EQ(list.getRows().getNbPairs(), nbPairs);
+  EXPECT_EQ(list.getGhostRows().size(), 0u);
+  EXPECT_EQ(list.getNbBuilds(), 1u);
+}
+
+/**
+ * @brief Test the rebuild criterion.
+ *
+ * This test checks that the list has to be rebuilt only once a
+ * particle moved by more than half of the skin, or was removed.
+ */
+TEST(VerletListTest, NeedsRebuild) {
+  ParticleStore store(2);
+  store.add(Vector({1.0, 1.0}), Vector(2), 1, "a");
+  store.add(Vector({2.0, 1.0}), Vector(2), 1, "b");
+
+  VerletList list(1.0, 0.2);
+  CellList cells(Vector({0, 0}), Vector({5, 5}), list.getRadius(),
+                 getDimensionKernels(2));
+  cells.fill(store);
+  list.build(store, cells);
+  EXPECT_FALSE(list.needsRebuild(store));
+
+  store.getPositions()[0] += Vector({0.09, 0.0});
+  EXPECT_FALSE(list.needsRebuild(store));
+
+  store.getPositions()[0] += Vector({0.02, 0.0});
+  EXPECT_TRUE(list.needsRebuild(store));
+
+  store.getPositions()[0] = Vector({1.0, 1.0});
+  store.removeIf([](size_t i) { return i == 1; });
+  EXPECT_TRUE(list.needsRebuild(store));
+}
@@ -0,0 +1,179 @@
+/**
+ * @file vtk_writer_test.cpp
+ * @author jules roques (jules.roques@grenoble-inp.org)
+ * @brief Unit tests for the VtkWriter class.
+ *
+ * This file contains unit tests for the VtkWriter class, which check
+ * the appended data of the VTK files in raw and base64 encodings,
+ * and the times of the collection file.
+ *
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <particle_store.hpp>
+#include <sstream>
+#include <string>
+#include <vector.hpp>
+#include <vector>
+#include <vtk_writer.hpp>
+
+/**
+ * @brief Content of a file
+ * @param fileName
+ * @return std::string
+ */
+static std::string readFile(const std::string& fileName) {
+  std::ifstream file(fileName, std::ios::binary);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+/**
+ * @brief Decodes base64 text
+ * @param text
+ * @return std::string
+ */
+static std::string decodeBase64(const std::string& text) {
+  const std::string digits =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string bytes;
+  for (size_t i = 0; i + 4 <= text.size(); i += 4) {
+    uint32_t group = 0;
+    size_t nbPadding = 0;
+    for (size_t j = 0; j < 4; j++) {
+      group <<= 6;
+      if (text[i + j] == '=') {
+        nbPadding++;
+      } else {
+        group |= digits.find(text[i + j]);
+      }
+    }
+    for (size_t j = 0; j < 3 - nbPadding; j++) {
+      bytes += static_cast<char>((group >> (16 - 8 * j)) & 255);
+    }
+  }
+  return bytes;
+}
+
+/**
+ * @brief Values of an appended block of a raw VTK file
+ * @param content content of the file
+ * @param offset offset of the block in the appended data
+ * @return std::vector<float>
+ */
+static std::vector<float> readRawBlock(const std::string& content,
+                                       size_t offset) {
+  size_t start = content.find('_', content.find("<AppendedData")) + 1;
+  uint64_t nbBytes;
+  std::memcpy(&nbBytes, content.data() + start + offset, sizeof(nbBytes));
+  std::vector<float> values(nbBytes / sizeof(float));
+  std::memcpy(values.data(), content.data() + start + offset + 8, nbBytes);
+  return values;
+}
+
+/**
+ * @brief Store of the tests: 2 particles in 2 dimensions
+ * @return ParticleStore
+ */
+static ParticleStore makeParticles() {
+  ParticleStore particles(2);
+  particles.add(Vector({1.0, 2.0}), Vector({0.5, -0.5}), 3.0, "");
+  particles.add(Vector({4.0, 5.0}), Vector({0.0, 1.0}), 6.0, "");
+  return particles;
+}
+
+/**
+ * @brief Test the raw appended data.
+ *
+ * This test checks that positions, velocities and masses are
+ * Float32 blocks of the appended data, at their declared offsets,
+ * with 3 components for vectors.
+ */
+TEST(VtkWriterTest, Raw) {
+  ParticleStore particles = makeParticles();
+  {
+    VtkWriter writer("vtk_test", 2);
+    writer.writeFrame(particles, 0);
+  }
+  std::string content = readFile("vtk_test/particles_00000.vtu");
+
+  // 8 bytes of header, then 6 floats for each vector block
+  ASSERT_NE(content.find("Name=\"Position\" NumberOfComponents=\"3\" "
+                         "format=\"appended\" offset=\"0\""),
+            std::string::npos);
+  ASSERT_NE(content.find("Name=\"Velocity\" NumberOfComponents=\"3\" "
+                         "format=\"appended\" offset=\"32\""),
+            std::string::npos);
+  ASSERT_NE(content.find("Name=\"Masse\" NumberOfComponents=\"1\" "
+                         "format=\"appended\" offset=\"64\""),
+            std::string::npos);
+  EXPECT_EQ(readRawBlock(content, 0),
+            std::vector<float>({1, 2, 0, 4, 5, 0}));
+  EXPECT_EQ(readRawBlock(content, 32),
+            std::vector<float>({0.5, -0.5, 0, 0, 1, 0}));
+  EXPECT_EQ(readRawBlock(content, 64), std::vector<float>({3, 6}));
+
+  system("rm -rf vtk_test");
+}
+
+/**
+ * @brief Test the base64 appended data.
+ *
+ * This test checks that the header and the values of a block
+ * are encoded separately.
+ */
+TEST(VtkWriterTest, Base64) {
+  ParticleStore particles = makeParticles();
+  {
+    VtkWriter writer("vtk_test", 2, BASE64);
+    writer.writeFrame(particles, 0);
+  }
+  std::string content = readFile("vtk_test/particles_00000.vtu");
+  size_t start = content.find('_', content.find("<AppendedData")) + 1;
+
+  // 8 bytes are encoded in 12 characters, 24 bytes in 32
+  std::string header = decodeBase64(content.substr(start, 12));
+  std::string values = decodeBase64(content.substr(start + 12, 32));
+  uint64_t nbBytes;
+  std::memcpy(&nbBytes, header.data(), sizeof(nbBytes));
+  ASSERT_EQ(nbBytes, 24u);
+  std::vector<float> positions(6);
+  std::memcpy(positions.data(), values.data(), nbBytes);
+  EXPECT_EQ(positions, std::vector<float>({1, 2, 0, 4, 5, 0}));
+
+  system("rm -rf vtk_test");
+}
+
+/**
+ * @brief Test the collection file.
+ *
+ * This test checks that the collection lists every file
+ * with the time of its frame.
+ */
+TEST(VtkWriterTest, Collection) {
+  ParticleStore particles = makeParticles();
+  {
+    VtkWriter writer("vtk_test", 2);
+    writer.writeFrame(particles, 0);
+    writer.writeFrame(particles, 0.25);
+    EXPECT_EQ(writer.getNbFrames(), 2u);
+  }
+  std::string content = readFile("vtk_test/particles.pvd");
+
+  EXPECT_NE(content.find("<DataSet timestep=\"0\" part=\"0\" "
+                         "file=\"particles_00000.vtu\"/>"),
+            std::string::npos);
+  EXPECT_NE(content.find("<DataSet timestep=\"0.25\" part=\"0\" "
+                         "file=\"particles_00001.vtu\"/>"),
+            std::string::npos);
+
+  system("rm -rf vtk_test");
+}